@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RUNLENGTH_SSE2 1
+#else
+#define RUNLENGTH_SSE2 0
+#endif
+
+// streaming run-length codec - a run of equal bytes becomes its length followed by the byte
+// - Text: decimal length, "aaab" <-> "3a1b", the bytes themselves must not be digits
+// - Varint: LEB128 length (7 bits per byte, high bit set on all but the last), any bytes
+// - encoder and decoder keep their state between update calls, so the input may arrive in chunks of any size
+//   and runs may span chunks; output goes through a fixed buffer handed to a write callback whenever it fills up
+// - runs are found 16 bytes at a time with SSE2 compares (8 bytes at a time in a 64-bit word elsewhere)
+enum class RunLengthFormat {
+    Text,
+    Varint,
+};
+
+namespace runLengthDetail {
+
+    // number of bytes in [p, end) equal to symbol before the first other byte
+    inline std::size_t runLength(const unsigned char* p, const unsigned char* end, unsigned char symbol)
+    {
+        const unsigned char* start = p;
+
+        // runs of one byte are the common case of poorly compressible input, they skip the vector setup
+        if (p == end || *p != symbol) return 0;
+        if (++p == end || *p != symbol) return 1;
+
+#if RUNLENGTH_SSE2
+        const __m128i pattern = _mm_set1_epi8(static_cast<char>(symbol));
+        for (; end - p >= 16; p += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const unsigned differ = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern))) & 0xFFFFu;
+            if (differ) return static_cast<std::size_t>(p - start) + std::countr_zero(differ);
+        }
+#else
+        const std::uint64_t pattern = 0x0101010101010101ull * symbol;
+        for (; end - p >= 8; p += 8) {
+            std::uint64_t block;
+            std::memcpy(&block, p, sizeof(block));
+            if (const std::uint64_t differ = block ^ pattern) {
+                const int bit = std::endian::native == std::endian::little ? std::countr_zero(differ) : std::countl_zero(differ);
+                return static_cast<std::size_t>(p - start) + bit / 8;
+            }
+        }
+#endif
+        while (p != end && *p == symbol) ++p;
+        return static_cast<std::size_t>(p - start);
+    }
+
+    // output buffer of fixed size, handed to write(std::span<const char>) whenever it is full
+    class OutputBuffer {
+    public:
+        explicit OutputBuffer(std::size_t capacity) : data(std::max<std::size_t>(capacity, 64)) {}
+
+        // room for at least bytes more, flushing first if necessary (bytes <= 64)
+        template<typename Write>
+        char* reserve(std::size_t bytes, Write& write) {
+            if (data.size() - used < bytes) flush(write);
+            return data.data() + used;
+        }
+
+        void commit(std::size_t bytes) { used += bytes; }
+
+        // count copies of symbol, in as many flushes as it takes
+        template<typename Write>
+        void fill(char symbol, std::uint64_t count, Write& write) {
+            // short runs are the common case of poorly compressible input - a fixed 16 byte store (the bytes past
+            // the run are overwritten later) compiles to one vector store instead of a memset call
+            if (count <= 16 && data.size() - used >= 16) {
+                std::memset(data.data() + used, symbol, 16);
+                used += static_cast<std::size_t>(count);
+                return;
+            }
+            while (count) {
+                if (used == data.size()) flush(write);
+                const std::size_t bytes = static_cast<std::size_t>(std::min<std::uint64_t>(count, data.size() - used));
+                std::memset(data.data() + used, symbol, bytes);
+                used += bytes;
+                count -= bytes;
+            }
+        }
+
+        template<typename Write>
+        void flush(Write& write) {
+            if (used) write(std::span<const char>(data.data(), used));
+            used = 0;
+        }
+
+    private:
+        std::vector<char> data;
+        std::size_t used = 0;
+    };
+
+    // buffer size of the stream functions and the default output buffer size
+    inline constexpr std::size_t blockSize = 64 * 1024;
+
+} // namespace runLengthDetail
+
+class RunLengthEncoder {
+public:
+    explicit RunLengthEncoder(RunLengthFormat format = RunLengthFormat::Varint, std::size_t bufferSize = runLengthDetail::blockSize)
+        : format(format), output(bufferSize) {}
+
+    // encode the next chunk of input, a run reaching the end of it stays open for the next chunk
+    template<typename Write>
+    void update(std::span<const char> input, Write&& write) {
+        // the open run is kept in locals, the output writes through char pointers would force it back to memory
+        unsigned char run = symbol;
+        std::uint64_t length = count;
+        const auto* p = reinterpret_cast<const unsigned char*>(input.data());
+        const auto* end = p + input.size();
+        while (p != end) {
+            if (length && *p != run) {
+                emitRun(run, length, write);
+                length = 0;
+            }
+            run = *p;
+            const std::size_t bytes = runLengthDetail::runLength(p, end, run);
+            length += bytes;
+            p += bytes;
+        }
+        symbol = run;
+        count = length;
+    }
+
+    // encode the open run and hand out everything still buffered, the encoder can start over afterwards
+    template<typename Write>
+    void finish(Write&& write) {
+        if (count) emitRun(symbol, count, write);
+        count = 0;
+        output.flush(write);
+    }
+
+private:
+    template<typename Write>
+    void emitRun(unsigned char run, std::uint64_t length, Write& write) {
+        // 10 varint bytes or 20 digits for the length, one for the symbol
+        char* out = output.reserve(32, write);
+        char* start = out;
+        if (format == RunLengthFormat::Varint) {
+            for (; length >= 0x80; length >>= 7) *out++ = static_cast<char>((length & 0x7F) | 0x80);
+            *out++ = static_cast<char>(length);
+        }
+        else {
+            if (run >= '0' && run <= '9') throw std::invalid_argument("run-length: digits cannot be text encoded");
+            out = std::to_chars(out, out + 20, length).ptr;
+        }
+        *out++ = static_cast<char>(run);
+        output.commit(static_cast<std::size_t>(out - start));
+    }
+
+    RunLengthFormat format;
+    runLengthDetail::OutputBuffer output;
+
+    // open run
+    unsigned char symbol = 0;
+    std::uint64_t count = 0;
+};
+
+class RunLengthDecoder {
+public:
+    explicit RunLengthDecoder(RunLengthFormat format = RunLengthFormat::Varint, std::size_t bufferSize = runLengthDetail::blockSize)
+        : format(format), output(bufferSize) {}
+
+    // decode the next chunk of encoded input, a length split across chunks is continued with the next one
+    template<typename Write>
+    void update(std::span<const char> input, Write&& write) {
+        if (format == RunLengthFormat::Varint) updateVarint(input, write);
+        else updateText(input, write);
+    }
+
+    // hand out everything still buffered, throws if the input ended inside a run
+    template<typename Write>
+    void finish(Write&& write) {
+        output.flush(write);
+        const bool truncated = lengthBytes != 0 || !inLength;
+        count = 0;
+        lengthBytes = 0;
+        inLength = true;
+        if (truncated) throw std::runtime_error("run-length: input ends inside a run");
+    }
+
+private:
+    // the loops keep the state in locals, the output writes through char pointers would force it back to memory
+
+    template<typename Write>
+    void updateVarint(std::span<const char> input, Write& write) {
+        std::uint64_t length = count;
+        std::size_t bytes = lengthBytes;
+        bool reading = inLength;
+        const char* p = input.data();
+        const char* end = p + input.size();
+        while (p != end) {
+            // a whole run with a one-byte length, the common case
+            if (bytes == 0 && end - p >= 2 && static_cast<unsigned char>(p[0]) < 0x80) {
+                if (p[0] == 0) throw std::runtime_error("run-length: run without a length");
+                output.fill(p[1], static_cast<unsigned char>(p[0]), write);
+                p += 2;
+                continue;
+            }
+
+            const char c = *p++;
+            const auto byte = static_cast<unsigned char>(c);
+            if (!reading) {
+                if (length == 0) throw std::runtime_error("run-length: run without a length");
+                output.fill(c, length, write);
+                length = 0;
+                bytes = 0;
+                reading = true;
+                continue;
+            }
+            if (bytes == 10 || (bytes == 9 && byte > 1)) throw std::runtime_error("run-length: length exceeds 64 bits");
+            length |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * bytes++);
+            reading = byte & 0x80;
+        }
+        count = length;
+        lengthBytes = bytes;
+        inLength = reading;
+    }
+
+    template<typename Write>
+    void updateText(std::span<const char> input, Write& write) {
+        std::uint64_t length = count;
+        std::size_t digits = lengthBytes;
+        for (const char c : input) {
+            const auto byte = static_cast<unsigned char>(c);
+            if (byte >= '0' && byte <= '9') {
+                if (length > (UINT64_MAX - (byte - '0')) / 10) throw std::runtime_error("run-length: length exceeds 64 bits");
+                length = length * 10 + (byte - '0');
+                ++digits;
+                continue;
+            }
+
+            // the first non-digit is the symbol of the run
+            if (length == 0) throw std::runtime_error("run-length: run without a length");
+            output.fill(c, length, write);
+            length = 0;
+            digits = 0;
+        }
+        count = length;
+        lengthBytes = digits;
+    }
+
+    RunLengthFormat format;
+    runLengthDetail::OutputBuffer output;
+
+    // length read so far, its number of bytes (digits), and whether the next byte still belongs to it (varint)
+    std::uint64_t count = 0;
+    std::size_t lengthBytes = 0;
+    bool inLength = true;
+};
+
+namespace runLengthDetail {
+
+    // runs codec over the stream in blocks, memory stays at two blocks however long the stream is
+    template<typename Codec>
+    void transcode(Codec& codec, std::istream& in, std::ostream& out)
+    {
+        auto write = [&out](std::span<const char> bytes) {
+            if (!out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) throw std::runtime_error("run-length: cannot write the output stream");
+        };
+
+        std::vector<char> block(blockSize);
+        while (in) {
+            in.read(block.data(), static_cast<std::streamsize>(block.size()));
+            codec.update(std::span<const char>(block.data(), static_cast<std::size_t>(in.gcount())), write);
+        }
+        if (in.bad()) throw std::runtime_error("run-length: cannot read the input stream");
+        codec.finish(write);
+    }
+
+    template<typename Codec>
+    std::string transcode(Codec& codec, std::string_view input)
+    {
+        std::string result;
+        auto write = [&result](std::span<const char> bytes) { result.append(bytes.data(), bytes.size()); };
+        codec.update(std::span<const char>(input.data(), input.size()), write);
+        codec.finish(write);
+        return result;
+    }
+
+} // namespace runLengthDetail
+
+// encode everything until the end of in to out
+inline void runLengthEncode(std::istream& in, std::ostream& out, RunLengthFormat format = RunLengthFormat::Varint)
+{
+    RunLengthEncoder encoder(format);
+    runLengthDetail::transcode(encoder, in, out);
+}
+
+// decode everything until the end of in to out
+inline void runLengthDecode(std::istream& in, std::ostream& out, RunLengthFormat format = RunLengthFormat::Varint)
+{
+    RunLengthDecoder decoder(format);
+    runLengthDetail::transcode(decoder, in, out);
+}
+
+inline std::string runLengthEncode(std::string_view input, RunLengthFormat format = RunLengthFormat::Varint)
+{
+    RunLengthEncoder encoder(format);
+    return runLengthDetail::transcode(encoder, input);
+}
+
+inline std::string runLengthDecode(std::string_view input, RunLengthFormat format = RunLengthFormat::Varint)
+{
+    RunLengthDecoder decoder(format);
+    return runLengthDetail::transcode(decoder, input);
+}
@@ -0,0 +1,197 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RunLength.h"
+
+using benchClock = std::chrono::steady_clock;
+
+static double elapsedSeconds(benchClock::time_point start, benchClock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// bytes with runs of 1 + geometric(1 / meanRun) length, the byte changes between runs
+static std::string runInput(std::size_t bytes, double meanRun, std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::geometric_distribution<std::size_t> extra(1.0 / meanRun);
+    std::uniform_int_distribution<int> alphabet('a', 'z');
+
+    std::string input;
+    input.reserve(bytes);
+    char symbol = 'a';
+    while (input.size() < bytes) {
+        char next;
+        do next = static_cast<char>(alphabet(rng)); while (next == symbol);
+        symbol = next;
+        input.append(std::min(bytes - input.size(), 1 + extra(rng)), symbol);
+    }
+    return input;
+}
+
+// byte by byte run detection, the way the HelloWorld demo walks its vector
+static std::size_t scalarEncode(std::string_view input, std::vector<char>& out)
+{
+    out.clear();
+    for (std::size_t i = 0; i < input.size();) {
+        std::size_t j = i + 1;
+        while (j < input.size() && input[j] == input[i]) ++j;
+        std::uint64_t length = j - i;
+        for (; length >= 0x80; length >>= 7) out.push_back(static_cast<char>((length & 0x7F) | 0x80));
+        out.push_back(static_cast<char>(length));
+        out.push_back(input[i]);
+        i = j;
+    }
+    return out.size();
+}
+
+// encode and decode throughput in GB/s of raw (decoded) bytes, best of a few rounds
+static void benchCodec()
+{
+    constexpr std::size_t bytes = 64 * 1024 * 1024;
+    constexpr int rounds = 3;
+
+    std::cout << "run-length codec, " << bytes / (1024 * 1024) << " MiB in memory, GB/s of decoded bytes" << std::endl;
+    std::cout << std::setw(12) << "mean run" << std::setw(8) << "format" << std::setw(10) << "ratio"
+        << std::setw(12) << "scalar enc" << std::setw(12) << "encode" << std::setw(12) << "decode" << std::endl;
+
+    std::vector<char> scalarOut;
+    scalarOut.reserve(2 * bytes);
+
+    for (const double meanRun : { 1.0, 4.0, 64.0, 4096.0 }) {
+        const std::string input = runInput(bytes, meanRun, 42);
+
+        for (const RunLengthFormat format : { RunLengthFormat::Varint, RunLengthFormat::Text }) {
+            double scalarBest = 1e9;
+            double encodeBest = 1e9;
+            double decodeBest = 1e9;
+            std::string encoded;
+            bool consistent = true;
+
+            for (int round = 0; round < rounds; ++round) {
+                if (format == RunLengthFormat::Varint) {
+                    const auto scalarStart = benchClock::now();
+                    scalarEncode(input, scalarOut);
+                    scalarBest = std::min(scalarBest, elapsedSeconds(scalarStart, benchClock::now()));
+                }
+
+                // the callbacks model a consumer of fixed memory, every block is handed on and forgotten
+                encoded.clear();
+                RunLengthEncoder encoder(format);
+                const auto encodeStart = benchClock::now();
+                encoder.update(std::span<const char>(input.data(), input.size()), [&encoded](std::span<const char> block) { encoded.append(block.data(), block.size()); });
+                encoder.finish([&encoded](std::span<const char> block) { encoded.append(block.data(), block.size()); });
+                encodeBest = std::min(encodeBest, elapsedSeconds(encodeStart, benchClock::now()));
+
+                // the decoded blocks are compared against the input instead of stored
+                std::size_t position = 0;
+                auto check = [&](std::span<const char> block) {
+                    consistent = consistent && input.compare(position, block.size(), block.data(), block.size()) == 0;
+                    position += block.size();
+                };
+                RunLengthDecoder decoder(format);
+                const auto decodeStart = benchClock::now();
+                decoder.update(std::span<const char>(encoded.data(), encoded.size()), check);
+                decoder.finish(check);
+                decodeBest = std::min(decodeBest, elapsedSeconds(decodeStart, benchClock::now()));
+                consistent = consistent && position == input.size();
+            }
+
+            if (!consistent || (format == RunLengthFormat::Varint && std::string_view(scalarOut.data(), scalarOut.size()) != encoded)) {
+                std::cerr << "run-length round trip differs from the input" << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+
+            std::cout << std::setw(12) << static_cast<int>(meanRun) << std::setw(8) << (format == RunLengthFormat::Varint ? "varint" : "text")
+                << std::setw(10) << std::fixed << std::setprecision(3) << static_cast<double>(encoded.size()) / bytes;
+            if (format == RunLengthFormat::Varint) std::cout << std::setw(12) << std::setprecision(2) << bytes / scalarBest / 1e9;
+            else std::cout << std::setw(12) << "-";
+            std::cout << std::setw(12) << std::setprecision(2) << bytes / encodeBest / 1e9
+                << std::setw(12) << bytes / decodeBest / 1e9 << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+}
+
+// file to file through the stream functions, memory stays at the codec blocks however large the file is
+static void benchStream()
+{
+    constexpr std::size_t bytes = 256 * 1024 * 1024;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "runlength_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path raw = directory / "raw";
+    const std::filesystem::path encoded = directory / "encoded";
+    const std::filesystem::path decoded = directory / "decoded";
+
+    // the file is written in blocks as well
+    {
+        std::ofstream out(raw, std::ios::binary);
+        for (std::size_t written = 0; written < bytes; written += 16 * 1024 * 1024) {
+            const std::string block = runInput(16 * 1024 * 1024, 64.0, static_cast<std::uint32_t>(written));
+            out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+    }
+
+    std::cout << "run-length streams, " << bytes / (1024 * 1024) << " MiB file, mean run 64" << std::endl;
+
+    const auto encodeStart = benchClock::now();
+    {
+        std::ifstream in(raw, std::ios::binary);
+        std::ofstream out(encoded, std::ios::binary);
+        runLengthEncode(in, out);
+    }
+    const auto encodeEnd = benchClock::now();
+    {
+        std::ifstream in(encoded, std::ios::binary);
+        std::ofstream out(decoded, std::ios::binary);
+        runLengthDecode(in, out);
+    }
+    const auto decodeEnd = benchClock::now();
+
+    const bool consistent = std::filesystem::file_size(decoded) == bytes;
+    std::cout << "encode " << std::fixed << std::setprecision(2) << bytes / elapsedSeconds(encodeStart, encodeEnd) / 1e9 << " GB/s, "
+        << "decode " << bytes / elapsedSeconds(encodeEnd, decodeEnd) / 1e9 << " GB/s, "
+        << "ratio " << std::setprecision(3) << static_cast<double>(std::filesystem::file_size(encoded)) / bytes << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+
+    std::filesystem::remove_all(directory);
+    if (!consistent) {
+        std::cerr << "decoded file differs in size from the input" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    struct Benchmark {
+        std::string_view name;
+        void (*run)();
+    };
+    const Benchmark benchmarks[] = {
+        { "codec", benchCodec },
+        { "stream", benchStream },
+    };
+
+    // no names - run everything, otherwise only the named benchmarks
+    for (const auto& benchmark : benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) selected = selected || benchmark.name == argv[i];
+        if (selected) {
+            benchmark.run();
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
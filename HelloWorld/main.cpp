@@ -13,6 +13,15 @@
 #include <vector>
 
 #include <utility> // ipair
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+#include "RunLength.h"
+
 constexpr auto& ipair = std::ranges::views::enumerate;
 
 auto print_subrange = [](std::ranges::viewable_range auto&& r)
@@ -75,6 +84,19 @@ static std::ostream& operator<<(std::ostream& os, const std::vector<T>& list)
     return os;
 }
 
+template<typename T>
+static std::ostream& operator<<(std::ostream& os, std::span<const T> list)
+{
+    os << "[ ";
+    for (const char* delim = ""; auto && v : list)
+    {
+        os << std::exchange(delim, ", ") << v;
+    }
+    os << " ]";
+
+    return os;
+}
+
 template<>
 static std::ostream& operator<< <char>(std::ostream& os, const std::vector<char>& list)
 {
@@ -88,12 +110,111 @@ static std::ostream& operator<< <char>(std::ostream& os, const std::vector<char>
     return os;
 }
 
+// k-element combinations of { 0, ..., n-1 } in lexicographic order, ranked through the combinatorial number system
+// - a combination is its sorted indices, rank 0 is { 0, 1, ..., k-1 }
+// - rank / unrank cost O(k) / O(n) with the precomputed part of the Pascal triangle they read, next is the O(k) successor
+// - any rank range can be unranked once and walked with next, so the space splits across threads
+class combination_space {
+public:
+    combination_space(std::size_t n, std::size_t k) : n(n), k(k) {
+        if (k > n) throw std::invalid_argument("combination_space: k > n");
+
+        // every entry is at most C(n, k), so an overflow anywhere means C(n, k) itself does not fit
+        pascal.assign(k + 1, std::vector<std::uint64_t>(n - k + 1, 1));
+        for (std::size_t j = 1; j <= k; ++j) {
+            for (std::size_t d = 1; d <= n - k; ++d) {
+                const std::uint64_t sum = pascal[j - 1][d] + pascal[j][d - 1];
+                if (sum < pascal[j - 1][d]) throw std::overflow_error("combination_space: C(n, k) exceeds 64 bits");
+                pascal[j][d] = sum;
+            }
+        }
+    }
+
+    std::size_t elements() const { return n; }
+    std::size_t subset_size() const { return k; }
+
+    // C(n, k)
+    std::uint64_t size() const { return pascal[k][n - k]; }
+
+    // C(i, j) for j <= k and i - j <= n - k (the entries rank and unrank read), 0 for j > i
+    std::uint64_t binomial(std::size_t i, std::size_t j) const { return j <= i ? pascal[j][i - j] : 0; }
+
+    // lexicographic rank - the mirrored combination { n-1-c } ranks in colexicographic order as sum C(n-1-c[i], k-i)
+    std::uint64_t rank(std::span<const std::size_t> combination) const {
+        std::uint64_t colex = 0;
+        for (std::size_t i = 0; i < k; ++i) colex += binomial(n - 1 - combination[i], k - i);
+        return size() - 1 - colex;
+    }
+
+    // inverse of rank, fills combination (k indices)
+    void unrank(std::uint64_t r, std::span<std::size_t> combination) const {
+        std::uint64_t colex = size() - 1 - r;
+        std::size_t b = n;
+        for (std::size_t i = 0; i < k; ++i) {
+            // largest b with C(b, k-i) <= colex, b only shrinks so the scan is O(n) in total
+            do --b; while (binomial(b, k - i) > colex);
+            colex -= binomial(b, k - i);
+            combination[i] = n - 1 - b;
+        }
+    }
+
+    // lexicographic successor in O(k), false after the last combination
+    bool next(std::span<std::size_t> combination) const {
+        std::size_t i = k;
+        while (i > 0 && combination[i - 1] == n - k + i - 1) --i;
+        if (i == 0) return false;
+        ++combination[i - 1];
+        for (std::size_t j = i; j < k; ++j) combination[j] = combination[j - 1] + 1;
+        return true;
+    }
+
+    // fn(combination) for every combination with rank in [first, last), in order
+    template<typename Fn>
+    void for_each(std::uint64_t first, std::uint64_t last, Fn&& fn) const {
+        if (first >= last) return;
+        std::vector<std::size_t> combination(k);
+        unrank(first, combination);
+        for (std::uint64_t r = first; r < last; ++r) {
+            fn(std::span<const std::size_t>(combination));
+            next(combination);
+        }
+    }
+
+    // fn(worker, combination) for every combination, spread over threads (0 picks hardware_concurrency)
+    // workers take chunks of consecutive ranks from a shared counter, so uneven work per combination still balances
+    // fn runs concurrently - it should accumulate per worker and have the results combined afterwards
+    template<typename Fn>
+    void parallel_for_each(std::size_t threads, Fn&& fn) const {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        const std::uint64_t total = size();
+        const std::uint64_t chunk = std::max<std::uint64_t>(1024, total / (threads * 64));
+        std::atomic<std::uint64_t> next_chunk{ 0 };
+
+        auto work = [&](std::size_t worker) {
+            for (std::uint64_t first = next_chunk.fetch_add(chunk); first < total; first = next_chunk.fetch_add(chunk)) {
+                for_each(first, std::min(first + chunk, total), [&](std::span<const std::size_t> combination) { fn(worker, combination); });
+            }
+        };
+
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(work, t);
+        work(0);
+    }
+
+private:
+    std::size_t n;
+    std::size_t k;
+
+    // pascal[j][d] = C(j + d, j) for j <= k and d <= n - k
+    std::vector<std::vector<std::uint64_t>> pascal;
+};
+
 // iterator for generating k-element subsets lazily
 template<typename T>
 class subset_iterator {
 private:
     const std::vector<T>& v;
-    std::vector<bool> selector;
+    std::vector<std::size_t> indices;
     bool valid;
 
 public:
@@ -102,20 +223,26 @@ public:
     using iterator_category = std::input_iterator_tag;
 
     subset_iterator(const std::vector<T>& vec, std::size_t k, bool is_end = false)
-        : v(vec), selector(vec.size(), false), valid(!is_end) {
-        if (!is_end) {
-            std::fill(selector.begin(), selector.begin() + k, true);
-        }
+        : v(vec), indices(k), valid(!is_end && k <= vec.size()) {
+        std::iota(indices.begin(), indices.end(), std::size_t{ 0 });
     }
 
-    // dereference: returns the current subset as a filtered range
+    // dereference: returns the current subset as a view of the selected elements, O(k)
     auto operator*() const {
-        return v | std::views::filter([&, i = 0](auto) mutable { return selector[i++]; });
+        return indices | std::views::transform([this](std::size_t i) { return v[i]; });
     }
 
-    // prefix increment: generate the next subset
+    // prefix increment: lexicographic successor of the indices, O(k)
     subset_iterator& operator++() {
-        valid = std::prev_permutation(selector.begin(), selector.end());
+        const std::size_t n = v.size();
+        const std::size_t k = indices.size();
+        std::size_t i = k;
+        while (i > 0 && indices[i - 1] == n - k + i - 1) --i;
+        valid = i > 0;
+        if (valid) {
+            ++indices[i - 1];
+            for (std::size_t j = i; j < k; ++j) indices[j] = indices[j - 1] + 1;
+        }
         return *this;
     }
 
@@ -139,6 +266,110 @@ public:
     auto end() const { return std::default_sentinel; }
 };
 
+// current subset of a subset_span_iterator - spans into the iterator's buffers, valid until it advances
+template<typename T>
+struct subset_spans {
+    using sum_type = decltype(std::declval<T>() + std::declval<T>());
+
+    std::span<const std::size_t> indices;  // sorted
+    std::span<const T> values;             // values[i] = v[indices[i]]
+    sum_type sum;                          // sum of values, kept up to date by delta
+};
+
+// iterator for k-element subsets in revolving-door order (Knuth, TAOCP 7.2.1.3, algorithm R)
+// - consecutive subsets differ in exactly one element, so the buffers and the sum change in O(1) amortized
+// - no allocation after construction, the indices, values and sum are handed out as subset_spans
+template<typename T>
+class subset_span_iterator {
+private:
+    const std::vector<T>* v;
+    std::vector<std::size_t> c;  // c[0..k) the sorted indices, c[k] = n as a sentinel
+    std::vector<T> values;
+    typename subset_spans<T>::sum_type sum{};
+    bool valid;
+
+    // c[i] leaves the subset, index enters it at the same position
+    void replace(std::size_t i, std::size_t index) {
+        sum = sum - values[i] + (*v)[index];
+        c[i] = index;
+        values[i] = (*v)[index];
+    }
+
+    // algorithm R, with Knuth's 1-based c_j as c[j - 1]
+    bool step() {
+        const std::size_t k = c.size() - 1;
+        if (k == 0) return false;
+
+        // easy case, the smallest index moves
+        if (k % 2 == 1) {
+            if (c[0] + 1 < c[1]) {
+                replace(0, c[0] + 1);
+                return true;
+            }
+        }
+        else if (c[0] > 0) {
+            replace(0, c[0] - 1);
+            return true;
+        }
+
+        bool decrease = k % 2 == 1;
+        for (std::size_t j = 2; j <= k; ++j, decrease = !decrease) {
+            if (decrease && c[j - 1] >= j) {
+                // { c_j-1, c_j } -> { j-2, c_j-1 }
+                replace(j - 1, c[j - 2]);
+                replace(j - 2, j - 2);
+                return true;
+            }
+            if (!decrease && c[j - 1] + 1 < c[j]) {
+                // { j-2, c_j } -> { c_j, c_j+1 }
+                replace(j - 2, c[j - 1]);
+                replace(j - 1, c[j - 1] + 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    using value_type = subset_spans<T>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+
+    subset_span_iterator(const std::vector<T>& vec, std::size_t k)
+        : v(&vec), c(k + 1), values(vec.begin(), vec.begin() + std::min(k, vec.size())), valid(k <= vec.size()) {
+        std::iota(c.begin(), c.end() - 1, std::size_t{ 0 });
+        c.back() = vec.size();
+        for (const T& value : values) sum = sum + value;
+    }
+
+    subset_spans<T> operator*() const {
+        return { std::span<const std::size_t>(c.data(), c.size() - 1), values, sum };
+    }
+
+    subset_span_iterator& operator++() {
+        valid = step();
+        return *this;
+    }
+
+    bool operator!=(std::default_sentinel_t) const {
+        return valid;
+    }
+};
+
+// custom range view for k-element subsets in revolving-door order, yields subset_spans
+template<typename T>
+class subset_span_view : public std::ranges::view_interface< subset_span_view<T> > {
+private:
+    const std::vector<T>& v;
+    std::size_t k;
+
+public:
+    subset_span_view(const std::vector<T>& vec, std::size_t subset_size) : v(vec), k(subset_size) {}
+
+    auto begin() const { return subset_span_iterator(v, k); }
+    auto end() const { return std::default_sentinel; }
+};
+
 template <typename T>
 class squared_accumulate
 {
@@ -194,8 +425,9 @@ private:
     T x;
 };
 
+// sorts v in place unless it is sorted already
 template<typename T>
-static T minDiffInVec(std::vector<T> v, bool bIsSorted = false)
+static T minDiffInSpan(std::span<T> v, bool bIsSorted = false)
 {
     T minDiff = std::numeric_limits<T>::max();
 
@@ -212,6 +444,12 @@ static T minDiffInVec(std::vector<T> v, bool bIsSorted = false)
     return minDiff;
 }
 
+template<typename T>
+static T minDiffInVec(std::vector<T> v, bool bIsSorted = false)
+{
+    return minDiffInSpan(std::span<T>(v), bIsSorted);
+}
+
 template<class Iter>
 void merge_sort(Iter first, Iter last)
 {
@@ -517,41 +755,38 @@ int main()
         std::vector<char> v = { 'a', 'a', 'a', 'b', 'c', 'c', 'x', 'a', 'd', 'd' };
         std::cout << v << std::endl;
 
-        std::string result("");
-        auto it = v.begin();
-        int counter = 1;
-        while (it != (v.end() - 1))
-        {
-            if (*it == *(it + 1))
-            {
-                ++counter;
-            }
-            else
-            {
-                result += std::to_string(counter);
-                result += std::string{ *it }; // std::string(1, *it)
-                counter = 1;
-            }
-            ++it;
-        }
-        result += std::to_string(counter);
-        result += std::string{ *it }; // std::string(1, *it)
-
+        // RunLength.h - streaming codec, the text format writes decimal lengths
+        const std::string result = runLengthEncode(std::string_view(v.data(), v.size()), RunLengthFormat::Text);
         std::cout << result << std::endl;
+
+        // a run longer than 9 and binary lengths (varint), the encoder takes the input in chunks
+        std::string varint;
+        RunLengthEncoder encoder(RunLengthFormat::Varint);
+        auto append = [&varint](std::span<const char> bytes) { varint.append(bytes.data(), bytes.size()); };
+        encoder.update(std::string_view("aaaaaaaaaaaa"), append);
+        encoder.update(std::string_view("aaaaaaab"), append);
+        encoder.finish(append);
+        std::cout << runLengthEncode(std::string(19, 'a') + "b", RunLengthFormat::Text) << " - varint bytes:";
+        for (const char byte : varint) std::cout << ' ' << static_cast<int>(static_cast<unsigned char>(byte));
+        std::cout << std::endl;
     }
     std::cout << std::endl;
 
     std::cout << "run-length decoding" << std::endl;
     {
-        const std::vector<char> v = { '2', 'a', '1', 'b', '3', 'c', '1', 'a', '4', 'x' };
+        const std::vector<char> v = { '2', 'a', '1', 'b', '3', 'c', '1', 'a', '1', '2', 'x' };
         std::cout << v << std::endl;
 
-        std::string result("");
-        for (auto it = v.begin(); it != v.end(); it += 2)
-        {
-            result += std::string(static_cast<int>(*it) - 48, *(it + 1));
-        }
+        const std::string result = runLengthDecode(std::string_view(v.data(), v.size()), RunLengthFormat::Text);
         std::cout << result << std::endl;
+
+        // malformed input is reported, not guessed
+        try {
+            runLengthDecode("3a4", RunLengthFormat::Text);
+        }
+        catch (const std::runtime_error& error) {
+            std::cout << error.what() << std::endl;
+        }
     }
     std::cout << std::endl;
 
@@ -594,6 +829,26 @@ int main()
     }
     std::cout << std::endl;
 
+    std::cout << "subset creation [int] - revolving-door order, spans into reused buffers" << std::endl;
+    {
+        const std::vector<int> subsetCreateIntVec = { 0, 1, 2, 5, 1 };
+        int k = 3;
+
+        // sorting copy for minDiffInSpan, allocated once
+        std::vector<int> sorted;
+        sorted.reserve(k);
+
+        for (const auto subset : subset_span_view(subsetCreateIntVec, k)) {
+            sorted.assign(subset.values.begin(), subset.values.end());
+
+            std::cout << subset.values << " at " << subset.indices;
+            std::cout << " = " << subset.sum;
+            std::cout << " | " << minDiffInSpan(std::span<int>(sorted));
+            std::cout << std::endl;
+        }
+    }
+    std::cout << std::endl;
+
     std::cout << "subset creation [char]" << std::endl;
     {
         const std::vector<char> subsetCreateCharVec = { 'a', 'b', 'c', 'x', 'a' };
@@ -613,6 +868,57 @@ int main()
     }
     std::cout << std::endl;
 
+    std::cout << "combinations - rank / unrank through the combinatorial number system, enumerated in parallel" << std::endl;
+    {
+        const combination_space space(40, 6);
+        std::cout << "C(40, 6) = " << space.size() << std::endl;
+
+        std::vector<std::size_t> combination(6);
+        for (const std::uint64_t r : { std::uint64_t{ 0 }, std::uint64_t{ 1 }, std::uint64_t{ 123456 }, space.size() - 1 }) {
+            space.unrank(r, combination);
+            std::cout << "unrank(" << r << ") = " << combination << " - rank " << space.rank(combination) << std::endl;
+        }
+
+        // sum of all index sums, once on a single thread and once split across the cores
+        std::uint64_t sequential = 0;
+        space.for_each(0, space.size(), [&](std::span<const std::size_t> c) {
+            sequential += std::accumulate(c.begin(), c.end(), std::uint64_t{ 0 });
+        });
+
+        const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::uint64_t> partial(threads * 8);  // 8 apart, workers do not share a cache line
+        space.parallel_for_each(threads, [&](std::size_t worker, std::span<const std::size_t> c) {
+            partial[worker * 8] += std::accumulate(c.begin(), c.end(), std::uint64_t{ 0 });
+        });
+        const std::uint64_t parallel = std::accumulate(partial.begin(), partial.end(), std::uint64_t{ 0 });
+        std::cout << "sum of index sums: " << sequential << " - parallel: " << parallel << std::endl;
+
+        // large n with k close to n - only C(n, k) has to fit into 64 bits, not every C(i, j) below it
+        for (const auto& [large_n, large_k] : { std::pair<std::size_t, std::size_t>{ 100, 99 }, { 200, 195 } }) {
+            const combination_space large(large_n, large_k);
+            std::vector<std::size_t> first(large_k);
+            std::vector<std::size_t> last(large_k);
+            large.unrank(0, first);
+            large.unrank(large.size() - 1, last);
+            bool round_trip = large.rank(first) == 0 && large.rank(last) == large.size() - 1;
+            std::vector<std::size_t> walked = first;
+            std::vector<std::size_t> unranked(large_k);
+            for (std::uint64_t r = 1; r < std::min<std::uint64_t>(large.size(), 1000); ++r) {
+                large.next(walked);
+                large.unrank(r, unranked);
+                round_trip = round_trip && walked == unranked && large.rank(walked) == r;
+            }
+            std::cout << "C(" << large_n << ", " << large_k << ") = " << large.size() << " - round trip: " << round_trip << std::endl;
+        }
+        try {
+            const combination_space overflow(68, 34);
+        }
+        catch (const std::overflow_error& error) {
+            std::cout << error.what() << std::endl;
+        }
+    }
+    std::cout << std::endl;
+
     std::cout << "filter a container using a predicate and transform it" << std::endl;
     {
         auto const ints = { 0, 1, 2, 3, 4, 5 };
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "NoUniqueAddress.h"
+
+// epoch based reclamation for a single data structure
+// - a thread claims one record for the duration of an operation (Guard) and announces the global epoch in it,
+//   so any number of threads may come and go
+// - unlinked nodes are stamped with the global epoch at retirement, a node stamped e is freed once the global epoch
+//   reached e + 2 - every operation that could still see it has finished by then
+// - the global epoch only advances when every running operation announced the current one
+template<typename Node>
+class EpochDomain {
+    struct Record;
+
+public:
+    // upper bound on concurrent operations, more threads wait for a free record
+    static constexpr std::size_t maxRecords = 128;
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // no operation may be running any more
+    ~EpochDomain() {
+        for (Record& record : records) {
+            for (Limbo& limbo : record.limbo) freeAll(limbo);
+        }
+    }
+
+    // claimed record with the current epoch announced, the record is given back on destruction
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& domain) : domain(domain), record(domain.claim()) {
+            // announce, then make sure the announced epoch was still current once the announcement was visible
+            std::uint64_t epoch = domain.globalEpoch.load();
+            while (true) {
+                record.announced.store(epoch * 2 + 1);
+                const std::uint64_t now = domain.globalEpoch.load();
+                if (now == epoch) break;
+                epoch = now;
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            record.announced.store(0, std::memory_order_release);
+            record.claimed.store(false, std::memory_order_release);
+        }
+
+        // node is unlinked, free it as soon as no running operation can reach it any more
+        void retire(Node* node) {
+            const std::uint64_t epoch = domain.globalEpoch.load();
+            Limbo& limbo = record.limbo[epoch % 3];
+            // the bucket still holds nodes of epoch - 3 (or older), those are safe already
+            if (limbo.epoch != epoch) {
+                freeAll(limbo);
+                limbo.epoch = epoch;
+            }
+            limbo.nodes.push_back(node);
+
+            if (limbo.nodes.size() % advanceInterval == 0) domain.tryAdvance(record);
+        }
+
+    private:
+        EpochDomain& domain;
+        Record& record;
+    };
+
+private:
+    // retirements between attempts to advance the global epoch
+    static constexpr std::size_t advanceInterval = 64;
+
+    // nodes retired in one epoch
+    struct Limbo {
+        std::uint64_t epoch = 0;
+        std::vector<Node*> nodes;
+    };
+
+    struct alignas(64) Record {
+        std::atomic<bool> claimed{ false };
+
+        // epoch * 2 + 1 while an operation runs, 0 otherwise
+        std::atomic<std::uint64_t> announced{ 0 };
+
+        // only touched by the thread holding the record
+        std::array<Limbo, 3> limbo;
+    };
+
+    static void freeAll(Limbo& limbo) {
+        for (Node* node : limbo.nodes) delete node;
+        limbo.nodes.clear();
+    }
+
+    Record& claim() {
+        // threads keep coming back to the record they used last
+        thread_local std::size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id()) % maxRecords;
+        for (std::size_t attempt = 0;; ++attempt) {
+            const std::size_t index = (hint + attempt) % maxRecords;
+            Record& record = records[index];
+            bool expected = false;
+            if (!record.claimed.load(std::memory_order_relaxed) &&
+                record.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                hint = index;
+                std::size_t used = usedRecords.load(std::memory_order_relaxed);
+                while (used <= index && !usedRecords.compare_exchange_weak(used, index + 1)) {}
+                return record;
+            }
+            if (attempt % maxRecords == maxRecords - 1) std::this_thread::yield();
+        }
+    }
+
+    // advance the global epoch if every running operation announced it, then free what became safe in record
+    void tryAdvance(Record& record) {
+        std::uint64_t epoch = globalEpoch.load();
+        const std::size_t used = usedRecords.load();
+        bool current = true;
+        for (std::size_t i = 0; i < used && current; ++i) {
+            const std::uint64_t announced = records[i].announced.load();
+            current = announced == 0 || announced == epoch * 2 + 1;
+        }
+        if (current && globalEpoch.compare_exchange_strong(epoch, epoch + 1)) ++epoch;
+
+        for (Limbo& limbo : record.limbo) {
+            if (limbo.epoch + 2 <= epoch) freeAll(limbo);
+        }
+    }
+
+    std::array<Record, maxRecords> records;
+
+    // records [0, usedRecords) have been claimed at least once
+    std::atomic<std::size_t> usedRecords{ 0 };
+
+    std::atomic<std::uint64_t> globalEpoch{ 0 };
+};
+
+// lock-free sorted set (Harris / Michael list)
+// - nodes keep the ListNode layout (value, next), the lowest bit of next marks a node as logically deleted
+// - deletion marks first and unlinks afterwards, traversals help unlinking marked nodes
+// - unlinked nodes are reclaimed through epochs (EpochDomain)
+// - duplicates are rejected, every value is present at most once
+template<typename T, typename Compare = std::less<T>>
+class ConcurrentSortedList {
+public:
+    struct Node {
+        T val;
+        std::atomic<std::uintptr_t> next;
+    };
+
+    ConcurrentSortedList() = default;
+
+    explicit ConcurrentSortedList(Compare comp) : comp(std::move(comp)) {}
+
+    ConcurrentSortedList(const ConcurrentSortedList&) = delete;
+    ConcurrentSortedList& operator=(const ConcurrentSortedList&) = delete;
+
+    // no operation may be running any more
+    ~ConcurrentSortedList() {
+        Node* node = pointerOf(head.load(std::memory_order_relaxed));
+        while (node) {
+            Node* next = pointerOf(node->next.load(std::memory_order_relaxed));
+            delete node;
+            node = next;
+        }
+    }
+
+    // insert value at its sorted position, false if it is present already
+    bool insert(const T& value) {
+        Guard guard(domain);
+        Node* node = nullptr;
+        while (true) {
+            const Position position = find(value, guard);
+            if (position.found) {
+                delete node;
+                return false;
+            }
+            if (!node) node = new Node{ value, 0 };
+            node->next.store(linkTo(position.cur), std::memory_order_relaxed);
+
+            std::uintptr_t expected = linkTo(position.cur);
+            if (position.prev->compare_exchange_strong(expected, linkTo(node))) {
+                count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    // delete the node holding value, false if there is none
+    bool deleteValue(const T& value) {
+        Guard guard(domain);
+        while (true) {
+            const Position position = find(value, guard);
+            if (!position.found) return false;
+
+            // logical deletion - whoever sets the mark owns the removal
+            Node* cur = position.cur;
+            std::uintptr_t next = cur->next.load();
+            if (isMarked(next) || !cur->next.compare_exchange_strong(next, next | markBit)) continue;
+            count.fetch_sub(1, std::memory_order_relaxed);
+
+            // physical deletion - if prev changed meanwhile another traversal unlinks the node
+            std::uintptr_t expected = linkTo(cur);
+            if (position.prev->compare_exchange_strong(expected, next)) guard.retire(cur);
+            else find(value, guard);
+            return true;
+        }
+    }
+
+    bool contains(const T& value) const {
+        Guard guard(domain);
+        return find(value, guard).found;
+    }
+
+    // number of values, exact only while no operation is running
+    std::size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // sorted copy of the values, weakly consistent:
+    // values present during the whole call are included, values inserted or deleted concurrently may or may not be
+    std::vector<T> snapshot() const {
+        std::vector<T> values;
+        Guard guard(domain);
+        walk(guard, [this, &values](const T& val) {
+            // a restarted traversal passes values collected already again
+            if (values.empty() || comp(values.back(), val)) values.push_back(val);
+            return false;
+        });
+        return values;
+    }
+
+    // visit a snapshot in sorted order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const T& val : snapshot()) fn(val);
+    }
+
+private:
+    using Domain = EpochDomain<Node>;
+    using Guard = typename Domain::Guard;
+
+    static constexpr std::uintptr_t markBit = 1;
+
+    static Node* pointerOf(std::uintptr_t link) { return reinterpret_cast<Node*>(link & ~markBit); }
+    static bool isMarked(std::uintptr_t link) { return (link & markBit) != 0; }
+    static std::uintptr_t linkTo(Node* node) { return reinterpret_cast<std::uintptr_t>(node); }
+
+    // prev is the unmarked link pointing to cur, cur is the first node for which the walk stopped (nullptr at the end)
+    struct Position {
+        std::atomic<std::uintptr_t>* prev;
+        Node* cur;
+        bool found;
+    };
+
+    // first node not ordered before value
+    Position find(const T& value, Guard& guard) const {
+        Position position = walk(guard, [this, &value](const T& val) { return !comp(val, value); });
+        position.found = position.cur && !comp(value, position.cur->val);
+        return position;
+    }
+
+    // walk from the head until stop(value) holds for an unmarked node, marked nodes on the way are unlinked
+    // nodes stay valid while the guard is held, the walk restarts from the head when unlinking a node fails
+    template<typename Stop>
+    Position walk(Guard& guard, Stop stop) const {
+        while (true) {
+            std::atomic<std::uintptr_t>* prev = &head;
+            Node* cur = pointerOf(prev->load(std::memory_order_acquire));
+
+            bool restart = false;
+            while (cur && !restart) {
+                const std::uintptr_t link = cur->next.load(std::memory_order_acquire);
+                Node* next = pointerOf(link);
+
+                if (!isMarked(link)) {
+                    if (stop(cur->val)) return { prev, cur, false };
+                    prev = &cur->next;
+                }
+                else {
+                    // fails if prev itself got marked or relinked meanwhile
+                    std::uintptr_t expected = linkTo(cur);
+                    if (!prev->compare_exchange_strong(expected, linkTo(next))) {
+                        restart = true;
+                        continue;
+                    }
+                    guard.retire(cur);
+                }
+                cur = next;
+            }
+            if (!restart) return { prev, nullptr, false };
+        }
+    }
+
+    // traversals help unlinking, so lookups modify links and reclaim nodes as well
+    mutable std::atomic<std::uintptr_t> head{ 0 };
+    mutable Domain domain;
+    std::atomic<std::size_t> count{ 0 };
+    LINKEDLIST_NO_UNIQUE_ADDRESS Compare comp;
+};
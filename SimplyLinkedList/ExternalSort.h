@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LinkedList.h"
+#include "NoUniqueAddress.h"
+#include "PersistentList.h"
+
+// external merge sort for more values than fit into memory
+// - values are collected into a buffer of at most memoryBudget bytes, every full buffer is stable sorted and spilled
+//   to a temporary run file (a small header followed by the packed values)
+// - the runs are merged with a loser tree over buffered sequential readers, the budget is split between the read
+//   buffers - more runs than the budget has buffers for are merged in several passes, neighbouring runs first
+// - the result is streamed into a LinkedList or into a list file (PersistentList.h), values that fit into a single
+//   buffer never touch the disk
+// - stable, values equal under comp keep the order in which they were added
+// - values have to be trivially copyable, run files are private to the sorter and removed with it
+
+struct ExternalSortOptions {
+    // bytes of values held in memory at once, the run buffer while adding and the read buffers while merging
+    // - the sorter's own memory, a list handed to add() keeps its node memory until add() returns
+    std::size_t memoryBudget = std::size_t{ 64 } << 20;
+
+    // run files go to a fresh subdirectory of this one
+    std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+};
+
+// totals over every sort a sorter ran
+struct ExternalSortStats {
+    std::uint64_t values = 0;
+
+    // runs spilled to disk, intermediate merge outputs included
+    std::size_t runs = 0;
+
+    // merge passes over the data, the final merge included
+    std::size_t mergePasses = 0;
+
+    std::uint64_t bytesWritten = 0;
+};
+
+template<typename T, ListOrdering<T> Compare = std::less<T>>
+class ExternalSorter {
+    static_assert(std::is_trivially_copyable_v<T>, "run files store values as raw bytes");
+
+public:
+    // no merge buffer gets smaller than this, a tiny budget is exceeded rather than reading a few values per call
+    static constexpr std::size_t minMergeBuffer = std::size_t{ 16 } << 10;
+
+    explicit ExternalSorter(ExternalSortOptions options = ExternalSortOptions(), Compare comp = Compare())
+        : options(std::move(options)), comp(std::move(comp)) {
+        buffer.reserve(bufferCapacity());
+    }
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    // removes the run files
+    ~ExternalSorter() {
+        discardRuns();
+    }
+
+    // add a value, a full buffer is sorted and spilled as a run
+    void push(const T& value) {
+        buffer.push_back(value);
+        ++stats.values;
+        if (buffer.size() == bufferCapacity()) spill();
+    }
+
+    template<std::ranges::input_range R> requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void addRange(R&& range) {
+        for (auto&& value : range) push(static_cast<T>(value));
+    }
+
+    // take over the values of a list, the list ends up empty
+    // every node is freed as soon as its value is buffered, but a pool allocator only puts it back on its free
+    // list - the list's memory is still held while the buffer fills, at most the list plus the memory budget,
+    // and the pool's chunks are returned once the list is empty
+    template<typename Allocator, typename Instrumentation>
+    void add(LinkedList<T, Allocator, Instrumentation>& list) {
+        list.markModified();
+        while (list.head) {
+            buffer.push_back(list.head->val);
+            ++stats.values;
+
+            auto* node = list.head;
+            list.head = node->next;
+            --list.count;
+            list.freeNode(node);
+
+            if (buffer.size() == bufferCapacity()) spill();
+        }
+        list.tail = nullptr;
+
+        // the pool holds nothing but freed nodes now (unless other lists share it)
+        if constexpr (requires(typename LinkedList<T, Allocator, Instrumentation>::NodeAllocator& a) { a.releaseAll(); }) {
+            list.alloc.releaseAll();
+        }
+    }
+
+    // values stored as raw bytes in the stream (e.g. a file of packed integers) until the end of the stream
+    void addStream(std::istream& in) {
+        while (in) {
+            const std::size_t free = bufferCapacity() - buffer.size();
+            const std::size_t filled = buffer.size();
+            buffer.resize(filled + free);
+            in.read(reinterpret_cast<char*>(buffer.data() + filled), static_cast<std::streamsize>(free * sizeof(T)));
+
+            const std::size_t bytes = static_cast<std::size_t>(in.gcount());
+            if (bytes % sizeof(T) != 0) throw std::runtime_error("external sort: input stream ends inside a value");
+            buffer.resize(filled + bytes / sizeof(T));
+            stats.values += bytes / sizeof(T);
+
+            if (buffer.size() == bufferCapacity()) spill();
+        }
+        if (in.bad()) throw std::runtime_error("external sort: cannot read the input stream");
+    }
+
+    // values added since the last sort
+    std::uint64_t size() const {
+        std::uint64_t values = buffer.size();
+        for (const Run& run : runs) values += run.count;
+        return values;
+    }
+
+    const ExternalSortStats& statistics() const { return stats; }
+
+    // append every value in sorted order to list, the sorter is empty afterwards
+    template<typename Allocator, typename Instrumentation>
+    void sortInto(LinkedList<T, Allocator, Instrumentation>& list) {
+        if (runs.empty()) {
+            std::stable_sort(buffer.begin(), buffer.end(), std::ref(comp));
+            for (const T& value : buffer) list.insert(value);
+        }
+        else {
+            RunMerger merger = mergeRuns();
+            for (; !merger.empty(); merger.pop()) list.insert(merger.front());
+        }
+        finished();
+    }
+
+    template<typename Allocator = PoolAllocator<T>, typename Instrumentation = NoInstrumentation>
+    LinkedList<T, Allocator, Instrumentation> sortedList(const Allocator& allocator = Allocator()) {
+        LinkedList<T, Allocator, Instrumentation> list(allocator);
+        sortInto(list);
+        return list;
+    }
+
+    // write every value in sorted order to a list file (see MappedList), the sorter is empty afterwards
+    void sortToListFile(const std::filesystem::path& path) {
+        if (runs.empty()) {
+            std::stable_sort(buffer.begin(), buffer.end(), std::ref(comp));
+            listFileDetail::writeSequential<T>(path, buffer.size(), buffer.begin(), buffer.end());
+        }
+        else {
+            RunMerger merger = mergeRuns();
+            const std::uint64_t count = merger.remaining();
+            listFileDetail::writeSequential<T>(path, count, MergeIterator(&merger), MergeIterator(nullptr));
+        }
+        finished();
+    }
+
+private:
+    // run file layout - header, then count packed values
+    struct RunHeader {
+        static constexpr char expectedMagic[8] = { 'S', 'L', 'R', 'U', 'N', '\0', '\0', '\x01' };
+
+        char magic[8];
+        std::uint32_t valueSize;
+        std::uint32_t reserved;
+        std::uint64_t count;
+    };
+
+    struct Run {
+        std::filesystem::path path;
+        std::uint64_t count = 0;
+    };
+
+    // buffered sequential writer of one run file, the value count is patched into the header on close
+    class RunWriter {
+    public:
+        RunWriter(const std::filesystem::path& path, std::size_t bufferValues) : path(path), out(path, std::ios::binary | std::ios::trunc) {
+            if (!out) throw std::runtime_error("external sort: cannot create run file " + path.string());
+            RunHeader header{};
+            std::memcpy(header.magic, RunHeader::expectedMagic, sizeof(header.magic));
+            header.valueSize = sizeof(T);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            buffer.reserve(bufferValues);
+        }
+
+        void write(const T& value) {
+            buffer.push_back(value);
+            if (buffer.size() == buffer.capacity()) flush();
+        }
+
+        void write(std::span<const T> values) {
+            flush();
+            out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+            count += values.size();
+        }
+
+        // bytes written in total
+        std::uint64_t close() {
+            flush();
+            out.seekp(offsetof(RunHeader, count));
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            if (!out.flush()) throw std::runtime_error("external sort: cannot write run file " + path.string());
+            out.close();
+            return sizeof(RunHeader) + count * sizeof(T);
+        }
+
+        std::uint64_t size() const { return count + buffer.size(); }
+
+    private:
+        void flush() {
+            out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+            count += buffer.size();
+            buffer.clear();
+        }
+
+        std::filesystem::path path;
+        std::ofstream out;
+        std::vector<T> buffer;
+        std::uint64_t count = 0;
+    };
+
+    // buffered sequential reader of one run file
+    class RunReader {
+    public:
+        RunReader(const Run& run, std::size_t bufferValues) : path(run.path), in(run.path, std::ios::binary) {
+            RunHeader header{};
+            if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                std::memcmp(header.magic, RunHeader::expectedMagic, sizeof(header.magic)) != 0 || header.valueSize != sizeof(T) ||
+                header.count != run.count) {
+                throw std::runtime_error("external sort: invalid run file " + path.string());
+            }
+            remaining = header.count;
+            buffer.resize(static_cast<std::size_t>(std::min<std::uint64_t>(bufferValues, remaining)));
+            refill();
+        }
+
+        bool empty() const { return position == filled; }
+        const T& front() const { return buffer[position]; }
+
+        void pop() {
+            if (++position == filled) refill();
+        }
+
+        // values not popped yet
+        std::uint64_t left() const { return remaining + (filled - position); }
+
+    private:
+        void refill() {
+            filled = static_cast<std::size_t>(std::min<std::uint64_t>(buffer.size(), remaining));
+            position = 0;
+            if (filled == 0) return;
+            if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(filled * sizeof(T)))) {
+                throw std::runtime_error("external sort: truncated run file " + path.string());
+            }
+            remaining -= filled;
+        }
+
+        std::filesystem::path path;
+        std::ifstream in;
+        std::vector<T> buffer;
+        std::size_t position = 0;
+        std::size_t filled = 0;
+        std::uint64_t remaining = 0;
+    };
+
+    // stable k-way merge of runs with a loser tree, ties go to the run with the lower index
+    class RunMerger {
+    public:
+        RunMerger(std::span<const Run> runs, std::size_t bufferValues, Compare& comp) : comp(comp) {
+            const std::size_t k = runs.size();
+            readers.reserve(k);
+            for (const Run& run : runs) {
+                readers.emplace_back(run, bufferValues);
+                if (!readers.back().empty()) ++active;
+            }
+
+            // complete binary tree: leaves k..2k-1 stand for the runs, inner node i keeps the loser of its subtree match
+            losers.resize(k);
+            std::vector<std::size_t> winners(2 * k);
+            for (std::size_t i = 0; i < k; ++i) winners[k + i] = i;
+            for (std::size_t node = k - 1; node >= 1; --node) {
+                const std::size_t left = winners[2 * node];
+                const std::size_t right = winners[2 * node + 1];
+                const bool leftWins = ahead(left, right);
+                winners[node] = leftWins ? left : right;
+                losers[node] = leftWins ? right : left;
+            }
+            winner = k > 0 ? winners[1] : 0;
+        }
+
+        bool empty() const { return active == 0; }
+        const T& front() const { return readers[winner].front(); }
+
+        void pop() {
+            RunReader& reader = readers[winner];
+            reader.pop();
+            if (reader.empty()) --active;
+
+            // replay the matches on the path from the winner's leaf to the root
+            for (std::size_t parent = (readers.size() + winner) / 2; parent >= 1; parent /= 2) {
+                if (ahead(losers[parent], winner)) std::swap(losers[parent], winner);
+            }
+        }
+
+        std::uint64_t remaining() const {
+            std::uint64_t values = 0;
+            for (const RunReader& reader : readers) values += reader.left();
+            return values;
+        }
+
+    private:
+        // true if run a is ahead of run b, drained runs lose against everything
+        bool ahead(std::size_t a, std::size_t b) const {
+            if (readers[a].empty()) return false;
+            if (readers[b].empty()) return true;
+            return a < b ? !comp(readers[b].front(), readers[a].front()) : comp(readers[a].front(), readers[b].front());
+        }
+
+        std::vector<RunReader> readers;
+        std::vector<std::size_t> losers;
+        std::size_t winner = 0;
+        std::size_t active = 0;
+        Compare& comp;
+    };
+
+    // input iterator over the merged values, the list file writer pulls them one by one
+    class MergeIterator {
+    public:
+        explicit MergeIterator(RunMerger* merger) : merger(merger && !merger->empty() ? merger : nullptr) {}
+
+        const T& operator*() const { return merger->front(); }
+
+        MergeIterator& operator++() {
+            merger->pop();
+            if (merger->empty()) merger = nullptr;
+            return *this;
+        }
+
+        friend bool operator==(const MergeIterator&, const MergeIterator&) = default;
+
+    private:
+        RunMerger* merger;
+    };
+
+    std::size_t bufferCapacity() const {
+        return std::max<std::size_t>(1, options.memoryBudget / sizeof(T));
+    }
+
+    // runs merged at once - one read buffer per run plus one write buffer for an intermediate output
+    std::size_t fanIn() const {
+        return std::max<std::size_t>(2, options.memoryBudget / minMergeBuffer - 1);
+    }
+
+    std::size_t mergeBufferValues(std::size_t runCount) const {
+        return std::max(options.memoryBudget / (runCount + 1), minMergeBuffer) / sizeof(T) + 1;
+    }
+
+    std::filesystem::path nextRunPath() {
+        if (directory.empty()) {
+            std::random_device random;
+            for (int attempt = 0; directory.empty(); ++attempt) {
+                const std::filesystem::path candidate =
+                    options.tempDirectory / ("external-sort-" + std::to_string((std::uint64_t{ random() } << 32) | random()));
+                std::error_code error;
+                if (std::filesystem::create_directory(candidate, error)) directory = candidate;
+                else if (error || attempt == 16) {
+                    throw std::runtime_error("external sort: cannot create a directory in " + options.tempDirectory.string());
+                }
+            }
+        }
+        return directory / ("run-" + std::to_string(nextRun++) + ".bin");
+    }
+
+    // sort the buffer and write it as the newest run
+    void spill() {
+        if (buffer.empty()) return;
+        std::stable_sort(buffer.begin(), buffer.end(), std::ref(comp));
+
+        Run run{ nextRunPath(), buffer.size() };
+        RunWriter writer(run.path, 0);
+        writer.write(std::span<const T>(buffer));
+        stats.bytesWritten += writer.close();
+        ++stats.runs;
+        runs.push_back(std::move(run));
+        buffer.clear();
+    }
+
+    // spill what is left, merge neighbouring runs until a single pass over the rest fits the budget
+    // the returned merger reads the remaining runs
+    RunMerger mergeRuns() {
+        spill();
+        buffer.clear();
+        buffer.shrink_to_fit();
+
+        const std::size_t maxRuns = fanIn();
+        while (runs.size() > maxRuns) {
+            std::vector<Run> merged;
+            for (std::size_t first = 0; first < runs.size(); first += maxRuns) {
+                const std::size_t group = std::min(maxRuns, runs.size() - first);
+                if (group == 1) {
+                    merged.push_back(std::move(runs[first]));
+                    continue;
+                }
+
+                const std::span<const Run> inputs(runs.data() + first, group);
+                Run output{ nextRunPath(), 0 };
+                {
+                    const std::size_t bufferValues = mergeBufferValues(group);
+                    RunMerger merger(inputs, bufferValues, comp);
+                    RunWriter writer(output.path, bufferValues);
+                    for (; !merger.empty(); merger.pop()) writer.write(merger.front());
+                    output.count = writer.size();
+                    stats.bytesWritten += writer.close();
+                }
+                for (const Run& input : inputs) removeRun(input);
+                ++stats.runs;
+                merged.push_back(std::move(output));
+            }
+            runs = std::move(merged);
+            ++stats.mergePasses;
+        }
+
+        ++stats.mergePasses;
+        return RunMerger(std::span<const Run>(runs), mergeBufferValues(runs.size()), comp);
+    }
+
+    static void removeRun(const Run& run) noexcept {
+        std::error_code ignored;
+        std::filesystem::remove(run.path, ignored);
+    }
+
+    void discardRuns() noexcept {
+        if (!directory.empty()) {
+            std::error_code ignored;
+            std::filesystem::remove_all(directory, ignored);
+        }
+        directory.clear();
+        runs.clear();
+    }
+
+    // the merge is done, start over with an empty sorter
+    void finished() {
+        discardRuns();
+        buffer.clear();
+        buffer.reserve(bufferCapacity());
+    }
+
+    ExternalSortOptions options;
+    LINKEDLIST_NO_UNIQUE_ADDRESS Compare comp;
+
+    // unsorted values of the run being collected
+    std::vector<T> buffer;
+
+    // spilled runs in the order they were written
+    std::vector<Run> runs;
+
+    // per-sorter subdirectory of options.tempDirectory, created with the first run
+    std::filesystem::path directory;
+    std::size_t nextRun = 0;
+
+    ExternalSortStats stats;
+};
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "LinkedList.h"
+#include "MembershipSet.h"
+
+// singly-linked list stored as a structure of arrays
+// - slot i holds values[i], links[i] is the slot of the next value (npos at the end)
+// - erased slots are chained into a free-list through links and recycled by later inserts
+// - 32-bit links: 8 bytes per int node instead of 16, at most 2^32 - 1 slots
+// - destruction and clear() are O(1) for trivially destructible values, compact() lays the values out in list order
+//   so values[0, size()) alone describes the list
+template<typename T>
+class IndexedList {
+public:
+    using Index = std::uint32_t;
+
+    // link of the last slot, link to nothing
+    static constexpr Index npos = ~Index{ 0 };
+
+    std::vector<T> values;
+    std::vector<Index> links;
+
+    Index head = npos;
+
+    // last slot for O(1) append, npos for an empty list
+    Index tail = npos;
+
+    // number of values in the list (not slots)
+    std::size_t count = 0;
+
+    IndexedList() = default;
+
+    std::size_t size() const { return count; }
+
+    // slots in use plus slots waiting on the free-list
+    std::size_t slots() const { return values.size(); }
+
+    // visit every value in list order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (Index slot = head; slot != npos; slot = links[slot]) fn(values[slot]);
+    }
+
+    // insert at the end
+    void insert(const T& val) {
+        append(newSlot(val));
+    }
+
+    void insert(T&& val) {
+        append(newSlot(std::move(val)));
+    }
+
+    // drop every value at once, the arrays keep their capacity
+    void clear() {
+        values.clear();
+        links.clear();
+        head = tail = freeHead = npos;
+        count = 0;
+    }
+
+    // delete all values equal to val
+    void deleteValue(const T& val) {
+        removeIf([&val](const T& x) { return x == val; });
+    }
+
+    // delete all values contained in deletes, looked up in a membership set picked for them (MembershipSet.h)
+    void deleteValues(std::vector<T>& deletes) {
+        if (head == npos || deletes.empty()) return;
+
+        std::vector<T> deleteSet(deletes.begin(), deletes.end());
+        std::sort(deleteSet.begin(), deleteSet.end());
+        deleteSet.erase(std::unique(deleteSet.begin(), deleteSet.end()), deleteSet.end());
+
+        withMembershipSet(std::span<const T>(deleteSet), [this](const auto& members) {
+            removeIf([&members](const T& x) { return members.contains(x); });
+        });
+    }
+
+    // delete the value at position size() / 2
+    void deleteMiddleNode() {
+        if (head == npos) return;
+
+        Index* link = &head;
+        for (std::size_t i = 0; i < count / 2; ++i) link = &links[*link];
+        const Index slot = *link;
+        *link = links[slot];
+        if (slot == tail) tail = link == &head ? npos : static_cast<Index>(link - links.data());
+        freeSlot(slot);
+        --count;
+    }
+
+    void reverseIterative() {
+        Index prev = npos;
+        Index slot = head;
+        while (slot != npos) {
+            const Index next = links[slot];
+            links[slot] = prev;
+            prev = slot;
+            slot = next;
+        }
+        tail = head;
+        head = prev;
+    }
+
+    // remove every value that has a greater value anywhere behind it
+    void removeNodesSmallerThanMaxSoFar() {
+        if (count < 2) return;
+
+        // the largest value seen from the back survives
+        reverseIterative();
+        Index maxSlot = head;
+        while (links[maxSlot] != npos) {
+            const Index slot = links[maxSlot];
+            if (values[slot] < values[maxSlot]) {
+                links[maxSlot] = links[slot];
+                freeSlot(slot);
+                --count;
+            }
+            else {
+                maxSlot = slot;
+            }
+        }
+        reverseIterative();
+    }
+
+    // stable in-place merge of another sorted list, its values move into slots of this list and it ends up empty
+    template<ListOrdering<T> Compare = std::less<T>>
+    void merge(IndexedList& other, Compare comp = Compare()) {
+        if (this == &other || other.head == npos) return;
+
+        // other's values are appended in its list order, so they form a consecutive run of slots
+        Run appended{};
+        for (Index slot = other.head; slot != npos; slot = other.links[slot]) {
+            const Index copy = pushSlot(std::move(other.values[slot]));
+            if (appended.head == npos) appended.head = copy;
+            else links[appended.tail] = copy;
+            appended.tail = copy;
+        }
+        count += other.count;
+        other.clear();
+
+        const Run merged = mergeRuns({ head, tail }, appended, comp);
+        head = merged.head;
+        tail = merged.tail;
+    }
+
+    template<ListOrdering<T> Compare = std::less<T>>
+    void insertionSort(Compare comp = Compare()) {
+        Index sorted = npos;
+        while (head != npos) {
+            const Index slot = head;
+            head = links[head];
+            Index* link = &sorted;
+            while (*link != npos && !comp(values[slot], values[*link])) link = &links[*link];
+            links[slot] = *link;
+            *link = slot;
+        }
+        head = sorted;
+        resetTail();
+    }
+
+    // swaps values, the links stay untouched
+    template<ListOrdering<T> Compare = std::less<T>>
+    void bubbleSort(Compare comp = Compare()) {
+        if (count < 2) return;
+
+        bool swapped;
+        do {
+            swapped = false;
+            for (Index slot = head; links[slot] != npos; slot = links[slot]) {
+                if (comp(values[links[slot]], values[slot])) {
+                    std::swap(values[slot], values[links[slot]]);
+                    swapped = true;
+                }
+            }
+        } while (swapped);
+    }
+
+    // stable bottom-up merge sort over the links, runs are merged like a binary counter
+    template<ListOrdering<T> Compare = std::less<T>>
+    void mergeSort(Compare comp = Compare()) {
+        if (count < 2) return;
+
+        constexpr std::size_t maxRuns = 64;
+        std::array<Run, maxRuns> runs{};
+        std::size_t usedRuns = 0;
+
+        Index slot = head;
+        while (slot != npos) {
+            const Index next = links[slot];
+            links[slot] = npos;
+
+            // runs[i] was built from earlier values than carry, it goes left to keep the sort stable
+            Run carry{ slot, slot };
+            std::size_t i = 0;
+            for (; runs[i].head != npos; ++i) {
+                carry = mergeRuns(runs[i], carry, comp);
+                runs[i] = {};
+            }
+            runs[i] = carry;
+            usedRuns = std::max(usedRuns, i + 1);
+
+            slot = next;
+        }
+
+        // fold the partial runs, higher runs are older
+        Run sorted{};
+        for (std::size_t i = 0; i < usedRuns; ++i) {
+            if (runs[i].head != npos) sorted = mergeRuns(runs[i], sorted, comp);
+        }
+        head = sorted.head;
+        tail = sorted.tail;
+    }
+
+    // move the values into list order and drop the free slots, afterwards slot i holds the i-th value
+    void compact() {
+        std::vector<T> ordered;
+        ordered.reserve(count);
+        for (Index slot = head; slot != npos; slot = links[slot]) ordered.push_back(std::move(values[slot]));
+
+        values = std::move(ordered);
+        links.resize(count);
+        for (std::size_t i = 0; i < count; ++i) links[i] = static_cast<Index>(i + 1);
+        head = count ? 0 : npos;
+        tail = count ? static_cast<Index>(count - 1) : npos;
+        if (count) links[tail] = npos;
+        freeHead = npos;
+    }
+
+    // display the list
+    void display() const {
+        forEach([](const T& val) { std::cout << val << " -> "; });
+        std::cout << "NULL" << std::endl;
+    }
+
+private:
+    // chain of slots [head, tail]
+    struct Run {
+        Index head = npos;
+        Index tail = npos;
+    };
+
+    // erased slots, chained through links
+    Index freeHead = npos;
+
+    template<typename V>
+    Index pushSlot(V&& val) {
+        if (values.size() >= npos) throw std::length_error("IndexedList: more than 2^32 - 1 slots");
+        // both vectors have to grow together, a failing value push takes its link back
+        links.push_back(npos);
+        try {
+            values.push_back(std::forward<V>(val));
+        }
+        catch (...) {
+            links.pop_back();
+            throw;
+        }
+        return static_cast<Index>(values.size() - 1);
+    }
+
+    // a recycled slot gets its value assigned, the previous (erased) value is overwritten only now
+    template<typename V>
+    Index newSlot(V&& val) {
+        if (freeHead == npos) return pushSlot(std::forward<V>(val));
+
+        const Index slot = freeHead;
+        values[slot] = std::forward<V>(val);
+        freeHead = links[slot];
+        links[slot] = npos;
+        return slot;
+    }
+
+    void freeSlot(Index slot) {
+        links[slot] = freeHead;
+        freeHead = slot;
+    }
+
+    void append(Index slot) {
+        if (head == npos) head = slot;
+        else links[tail] = slot;
+        tail = slot;
+        ++count;
+    }
+
+    void resetTail() {
+        tail = head;
+        if (tail == npos) return;
+        while (links[tail] != npos) tail = links[tail];
+    }
+
+    template<typename Pred>
+    void removeIf(Pred pred) {
+        Index* link = &head;
+        Index last = npos;
+        while (*link != npos) {
+            const Index slot = *link;
+            if (pred(values[slot])) {
+                *link = links[slot];
+                freeSlot(slot);
+                --count;
+            }
+            else {
+                last = slot;
+                link = &links[slot];
+            }
+        }
+        tail = last;
+    }
+
+    // stable merge of two sorted runs, on equal values left comes first
+    template<typename Compare>
+    Run mergeRuns(Run left, Run right, Compare& comp) {
+        if (left.head == npos) return right;
+        if (right.head == npos) return left;
+
+        Index mergedHead = npos;
+        Index* last = &mergedHead;
+        Index l = left.head;
+        Index r = right.head;
+        while (l != npos && r != npos) {
+            if (comp(values[r], values[l])) {
+                *last = r;
+                r = links[r];
+            }
+            else {
+                *last = l;
+                l = links[l];
+            }
+            last = &links[*last];
+        }
+        *last = l != npos ? l : r;
+        return { mergedHead, l != npos ? left.tail : right.tail };
+    }
+};
@@ -0,0 +1,2039 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <span>
+#include <functional>
+#include <future>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#include "ListInstrumentation.h"
+#include "MembershipSet.h"
+#include "NodePool.h"
+#include "NoUniqueAddress.h"
+
+// full invariant check after every mutating operation (debug builds by default)
+#ifndef LINKEDLIST_CHECK_INVARIANTS
+#ifdef NDEBUG
+#define LINKEDLIST_CHECK_INVARIANTS 0
+#else
+#define LINKEDLIST_CHECK_INVARIANTS 1
+#endif
+#endif
+
+// hint the cache to fetch the memory at p, no-op where no intrinsic is available
+inline void prefetchRead(const void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+// tag of the range constructor (C++23), declared here when the standard library does not have it yet
+#ifdef __cpp_lib_containers_ranges
+using std::from_range;
+using std::from_range_t;
+#else
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+inline constexpr from_range_t from_range{};
+#endif
+
+// read-only traversal modes of LinkedList::forEach
+enum class Traversal {
+    Plain,
+    // the next node is requested before the current one is visited
+    Prefetch,
+};
+
+// singly-linked list
+template<typename T>
+struct ListNode {
+    T val;
+    ListNode* next;
+    ListNode() : val(), next(nullptr) {}
+    ListNode(const T& x) : val(x), next(nullptr) {}
+    ListNode(T&& x) : val(std::move(x)), next(nullptr) {}
+    ListNode(const T& x, ListNode* next) : val(x), next(next) {}
+    ListNode(T&& x, ListNode* next) : val(std::move(x)), next(next) {}
+
+    // construct the value in place from arbitrary arguments
+    template<typename... Args>
+    explicit ListNode(std::in_place_t, Args&&... args) : val(std::forward<Args>(args)...), next(nullptr) {}
+};
+
+// comparator usable by the sorts and merges
+// checked against references so stateful comparators are never copied along the recursion
+template<typename Compare, typename T>
+concept ListOrdering = std::strict_weak_order<Compare&, const T&, const T&>;
+
+// standard orderings on integers are served by radix sort instead of comparisons
+template<typename Compare, typename T>
+inline constexpr bool isStandardAscending =
+    std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::ranges::less>;
+
+template<typename Compare, typename T>
+inline constexpr bool isStandardDescending =
+    std::is_same_v<Compare, std::greater<T>> || std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::ranges::greater>;
+
+template<typename Compare, typename T>
+concept RadixSortable = std::integral<T> && !std::is_same_v<T, bool> &&
+    (isStandardAscending<Compare, T> || isStandardDescending<Compare, T>);
+
+// nodes come from Allocator rebound to ListNode<T>
+// the default PoolAllocator gives every list its own slab pool (NodePool.h)
+// Instrumentation picks the per-operation counters at compile time (ListInstrumentation.h), none by default
+template<typename T, typename Allocator = PoolAllocator<T>, typename Instrumentation = NoInstrumentation>
+class LinkedList {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using ListNode = ::ListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ListNode>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    // runtime-selected ordering, only used through the type-erased overloads
+    using DynamicOrdering = std::function<bool(const T&, const T&)>;
+
+    // detached run of nodes [head, tail], tail->next is nullptr
+    struct Chain {
+        ListNode* head = nullptr;
+        ListNode* tail = nullptr;
+    };
+
+    // forward iterator over the values, an iterator converts to a const_iterator
+    // before_begin() is the position in front of the head, it can only be incremented or passed to insert_after / erase_after
+    template<bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+
+        // a template, so the implicit copy constructor stays
+        template<bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) : node(other.node), beforeHead(other.beforeHead) {}
+
+        reference operator*() const { return node->val; }
+        pointer operator->() const { return &node->val; }
+
+        Iterator& operator++() {
+            node = node ? node->next : *std::exchange(beforeHead, nullptr);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator&, const Iterator&) = default;
+
+    private:
+        friend class LinkedList;
+        template<bool>
+        friend class Iterator;
+
+        explicit Iterator(ListNode* node, ListNode** beforeHead = nullptr) : node(node), beforeHead(beforeHead) {}
+
+        // link following the position, the list's head for before_begin()
+        ListNode*& nextLink() const { return node ? node->next : *beforeHead; }
+
+        ListNode* node = nullptr;
+
+        // head of the list for before_begin(), nullptr otherwise
+        ListNode** beforeHead = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // deeper recursion in reverseRecursive continues iteratively
+    static constexpr std::size_t maxRecursionDepth = std::size_t{ 1 } << 12;
+
+    ListNode* head;
+
+    // last node for O(1) append, nullptr for an empty list
+    ListNode* tail;
+
+    // cached number of nodes
+    std::size_t count;
+
+    // every node of the list is allocated through this allocator
+    NodeAllocator alloc;
+
+    // bumped by every operation changing the chain (indexes over the list rebuild when it moves, SkipListIndex.h)
+    // code relinking head / tail directly has to call markModified() itself
+    std::uint64_t modifications = 0;
+
+    // nodes visited, allocated and freed and comparator calls of every bulk operation, counted per list
+    // with CountingInstrumentation (e.g. instrumentation.writeJson(std::cout)), takes no space by default
+    LINKEDLIST_NO_UNIQUE_ADDRESS Instrumentation instrumentation;
+
+    LinkedList() : head(nullptr), tail(nullptr), count(0), alloc() {}
+
+    explicit LinkedList(const Allocator& allocator) : head(nullptr), tail(nullptr), count(0), alloc(allocator) {}
+
+    // copy constructor
+    // to initialize a previously uninitialized object from some other object's data
+    LinkedList(const LinkedList& other)
+        : head(nullptr), tail(nullptr), count(0), alloc(NodeTraits::select_on_container_copy_construction(other.alloc)) {
+        const Operation operation(instrumentation, "copy");
+        for (ListNode* node = other.head; node; node = node->next) {
+            Instrumentation::visited();
+            insert(node->val);
+        }
+        debugCheckInvariants();
+    }
+
+    // build from any input range in one pass, every node is linked right after it is created
+    template<std::ranges::input_range R> requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    LinkedList(from_range_t, R&& range, const Allocator& allocator = Allocator())
+        : LinkedList(allocator) {
+        const Operation operation(instrumentation, "fromRange");
+        ListNode** link = &head;
+        for (auto&& val : range) {
+            tail = *link = newNode(std::in_place, std::forward<decltype(val)>(val));
+            link = &tail->next;
+            ++count;
+        }
+        debugCheckInvariants();
+    }
+
+    // move constructor - steals the chain and the allocator, no node is touched
+    LinkedList(LinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)),
+          count(std::exchange(other.count, 0)), alloc(std::move(other.alloc)) {
+        other.markModified();
+    }
+
+    // allocate and construct a node through the list's allocator
+    template<typename... Args>
+    ListNode* newNode(Args&&... args) {
+        ListNode* node = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, node, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            NodeTraits::deallocate(alloc, node, 1);
+            throw;
+        }
+        Instrumentation::allocated();
+        return node;
+    }
+
+    // destroy a single node and give it back to the allocator
+    void freeNode(ListNode* node) {
+        NodeTraits::destroy(alloc, node);
+        NodeTraits::deallocate(alloc, node, 1);
+        Instrumentation::freed();
+    }
+
+    // delete every node
+    // trivially destructible values living in an exclusively owned pool are dropped in bulk
+    void clear() {
+        const Operation operation(instrumentation, "clear");
+        markModified();
+        bool released = false;
+        if constexpr (std::is_trivially_destructible_v<T> && requires(NodeAllocator& a) { a.releaseAll(); }) {
+            released = alloc.releaseAll();
+        }
+        if (released) {
+            Instrumentation::freed(count);
+        }
+        else {
+            while (head) {
+                Instrumentation::visited();
+                ListNode* next = head->next;
+                freeNode(head);
+                head = next;
+            }
+        }
+        head = tail = nullptr;
+        count = 0;
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    void markModified() {
+        ++modifications;
+    }
+
+    bool empty() const { return count == 0; }
+
+    iterator begin() { return iterator(head); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator cbegin() const { return begin(); }
+
+    iterator end() { return iterator(nullptr); }
+    const_iterator end() const { return const_iterator(nullptr); }
+    const_iterator cend() const { return end(); }
+
+    iterator before_begin() { return iterator(nullptr, &head); }
+    const_iterator before_begin() const { return const_iterator(nullptr, const_cast<ListNode**>(&head)); }
+    const_iterator cbefore_begin() const { return before_begin(); }
+
+    // insert behind pos, returns the position of the new value
+    iterator insert_after(const_iterator pos, const T& val) {
+        return linkAfter(pos, newNode(val));
+    }
+
+    iterator insert_after(const_iterator pos, T&& val) {
+        return linkAfter(pos, newNode(std::move(val)));
+    }
+
+    template<typename... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args) {
+        return linkAfter(pos, newNode(std::in_place, std::forward<Args>(args)...));
+    }
+
+    // erase the value behind pos, returns the position following the erased one
+    iterator erase_after(const_iterator pos) {
+        return erase_after(pos, const_iterator(pos.nextLink()->next));
+    }
+
+    // erase the values in (pos, last), returns last
+    iterator erase_after(const_iterator pos, const_iterator last) {
+        const Operation operation(instrumentation, "erase_after");
+        markModified();
+        ListNode** link = &pos.nextLink();
+        while (*link != last.node) {
+            Instrumentation::visited();
+            if (*link == tail) tail = pos.node;
+            unlinkAt(link);
+        }
+        debugCheckInvariants();
+        return iterator(last.node);
+    }
+
+    // walk the chain and verify head / tail / count agree with it
+    bool checkInvariants() const
+    {
+        if (!head) return !tail && count == 0;
+        if (!tail || tail->next) return false;
+
+        std::size_t nodes = 1;
+        const ListNode* last = head;
+        while (last->next) {
+            last = last->next;
+            ++nodes;
+        }
+
+        return last == tail && nodes == count;
+    }
+
+    // recompute tail and count after the whole chain has been relinked
+    void resetTailAndCount()
+    {
+        count = 0;
+        tail = nullptr;
+        for (ListNode* node = head; node; node = node->next) {
+            tail = node;
+            ++count;
+        }
+    }
+
+    // assignment operator
+    // to replace the data of a previously initialized object with some other object's data
+    LinkedList& operator=(const LinkedList& other) {
+        if (this == &other) return *this; // handle self-assignment
+        const Operation operation(instrumentation, "copyAssign");
+
+        // clear existing list
+        clear();
+
+        // copy from other
+        for (ListNode* node = other.head; node; node = node->next) {
+            Instrumentation::visited();
+            insert(node->val);
+        }
+        debugCheckInvariants();
+        return *this;
+    }
+
+    // move assignment - takes over the chain, elements are moved one by one only for unequal non-propagating allocators
+    LinkedList& operator=(LinkedList&& other) noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+        if (this == &other) return *this; // handle self-assignment
+
+        clear();
+        if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+            alloc = std::move(other.alloc);
+        }
+        else if (!(alloc == other.alloc)) {
+            const Operation operation(instrumentation, "moveAssign");
+            for (ListNode* node = other.head; node; node = node->next) {
+                Instrumentation::visited();
+                insert(std::move(node->val));
+            }
+            other.clear();
+            return *this;
+        }
+
+        head = std::exchange(other.head, nullptr);
+        tail = std::exchange(other.tail, nullptr);
+        count = std::exchange(other.count, 0);
+        other.markModified();
+        return *this;
+    }
+
+    // insert at the end
+    void insert(const T& val) {
+        append(newNode(val));
+    }
+
+    void insert(T&& val) {
+        append(newNode(std::move(val)));
+    }
+
+    // construct a value in place at the end
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        append(newNode(std::in_place, std::forward<Args>(args)...));
+        return tail->val;
+    }
+
+    // link an already constructed node at the end
+    void append(ListNode* node) {
+        markModified();
+        node->next = nullptr;
+        if (!head) {
+            head = node;
+        }
+        else {
+            tail->next = node;
+        }
+        tail = node;
+        ++count;
+    }
+
+    // delete all nodes with a specific value
+    void deleteValue(const T& val)
+    {
+        const Operation operation(instrumentation, "deleteValue");
+        markModified();
+        while (head && head->val == val) {
+            Instrumentation::visited();
+            ListNode* temp = head;
+            head = head->next;
+            freeNode(temp);
+            --count;
+        }
+        ListNode* current = head;
+        while (current && current->next) {
+            Instrumentation::visited();
+            if (current->next->val == val) {
+                ListNode* temp = current->next;
+                current->next = current->next->next;
+                freeNode(temp);
+                --count;
+            }
+            else {
+                current = current->next;
+            }
+        }
+
+        // traversal stops on the last remaining node
+        tail = current;
+        debugCheckInvariants();
+    }
+
+    // delete all nodes with a specific values
+    // while the list runs ascending the sorted delete values are merged alongside it,
+    // from the first node breaking that order on lookups go to a membership set picked for the values (MembershipSet.h)
+    void deleteValues(std::vector<T>& values)
+    {
+        const Operation operation(instrumentation, "deleteValues");
+        if (!head || values.empty())
+            return;
+        markModified();
+
+        std::vector<T> deleteSet(values.begin(), values.end());
+        std::sort(deleteSet.begin(), deleteSet.end());
+        deleteSet.erase(std::unique(deleteSet.begin(), deleteSet.end(), [](const T& a, const T& b) { return !(a < b); }), deleteSet.end());
+
+        // link to the current node - starts at head to handle head deletions
+        ListNode** link = &head;
+        ListNode* current = nullptr;
+
+        // sorted-merge path - valid as long as every visited value is above the delete values already passed
+        auto next = deleteSet.cbegin();
+        while (*link) {
+            Instrumentation::visited();
+            const T& val = (*link)->val;
+            if (next != deleteSet.cbegin() && !(*(next - 1) < val)) break;
+
+            while (next != deleteSet.cend() && *next < val) ++next;
+            if (next != deleteSet.cend() && !(val < *next)) {
+                unlinkAt(link);
+            }
+            else {
+                current = *link;
+                link = &current->next;
+            }
+        }
+
+        if (*link) {
+            withMembershipSet(std::span<const T>(deleteSet), [&](const auto& members) {
+                while (*link) {
+                    Instrumentation::visited();
+                    // whether value should be deleted
+                    if (members.contains((*link)->val)) {
+                        unlinkAt(link);
+                    }
+                    else {
+                        current = *link;
+                        link = &current->next; // progress with traversal
+                    }
+                }
+            });
+        }
+
+        tail = current; // traversal stops on the last remaining node
+        debugCheckInvariants();
+    }
+
+    // delete the middle node
+    void deleteMiddleNode()
+    {
+        const Operation operation(instrumentation, "deleteMiddleNode");
+        if (!head)
+            return;
+        markModified();
+
+        // calc mid position from the cached size
+        std::size_t middleOffset = count / 2;
+        ListNode* temp = nullptr;
+
+        // find mid list element
+        ListNode* midElement = head;
+        Instrumentation::visited();
+        while (middleOffset-- > 1)
+        {
+            Instrumentation::visited();
+            midElement = midElement->next;
+        }
+
+        // eliminate mid list element
+        if (midElement->next)
+        {
+            temp = midElement->next;
+            midElement->next = midElement->next->next;
+            if (temp == tail) tail = midElement;
+            freeNode(temp);
+            temp = nullptr;
+        }
+        else
+        {
+            // only one element
+            freeNode(head);
+            head = tail = nullptr;
+        }
+        --count;
+        debugCheckInvariants();
+    }
+
+    void reverseIterative()
+    {
+        const Operation operation(instrumentation, "reverseIterative");
+        markModified();
+        tail = head; // old first node is the new last one
+        head = reverseChain(head); // update head to the new first node
+        debugCheckInvariants();
+    }
+
+    // reverse a chain of nodes, returns the new first node
+    static ListNode* reverseChain(ListNode* current)
+    {
+        ListNode* prev = nullptr;
+        ListNode* next = nullptr;
+
+        while (current) {
+            Instrumentation::visited();
+            next = current->next; // store next node
+            current->next = prev; // reverse the link
+            prev = current;       // move prev forward
+            current = next;       // move current forward
+        }
+
+        return prev;
+    }
+
+    void reverseRecursive() {
+        const Operation operation(instrumentation, "reverseRecursive");
+        markModified();
+        tail = head;
+        head = reverseRecursiveInternal(head);
+        debugCheckInvariants();
+    }
+
+    // recursion depth is capped by maxRecursionDepth - the rest of a long chain is reversed iteratively
+    ListNode* reverseRecursiveInternal(ListNode* node, std::size_t depth = 0)
+    {
+        // base case - last node becomes new head
+        if (!node || !node->next) return node; 
+        Instrumentation::visited();
+
+        // stack budget used up, node becomes the last node of the reversed rest
+        if (depth == maxRecursionDepth) return reverseChain(node);
+
+        // recursively reverse rest
+        ListNode* newHead = reverseRecursiveInternal(node->next, depth + 1);
+        // reverse the link
+        node->next->next = node;
+        // set current nodes next to null
+        node->next = nullptr;    
+
+        // return new head node
+        return newHead; 
+    }
+
+    void removeNodesSmallerThanMaxSoFar()
+    {
+        const Operation operation(instrumentation, "removeNodesSmallerThanMaxSoFar");
+        // empty or single-node list
+        if (!head || !head->next)
+            return;
+        markModified();
+
+        // step 1 - reverse the linked list
+        reverseIterative();
+
+        // step 2 - remove nodes that are smaller than the max seen so far
+        ListNode* maxNode = head; // first node is the max initially
+
+        ListNode* current = head;
+        while (current && current->next) {
+            Instrumentation::visited();
+            if (current->next->val < maxNode->val) {
+                // delete the smaller node
+                ListNode* temp = current->next;
+                current->next = current->next->next;
+                freeNode(temp);
+                --count;
+            }
+            else {
+                // update maxNode if we find a larger value
+                current = current->next;
+                maxNode = current;
+            }
+        }
+
+        // step 3 - reverse back to original order
+        reverseIterative();
+    }
+
+    // in-place merge another sorted linked-list
+    template<ListOrdering<T> Compare = std::less<T>>
+    void merge(LinkedList& other, Compare comp = Compare())
+    {
+        // source linked-list is empty, nothing to do
+        if (!other.head || this == &other) return;
+        const Operation operation(instrumentation, "merge");
+        markModified();
+        other.markModified();
+
+        // nodes of the other list are stolen - take over the memory backing them
+        // if that is not possible the values are moved into nodes of our own allocator first
+        if (!adoptNodesOf(other)) {
+            LinkedList moved(SameNodes{}, alloc);
+            for (ListNode* node = other.head; node; node = node->next) {
+                Instrumentation::visited();
+                moved.insert(std::move(node->val));
+            }
+            other.clear();
+            merge(moved, comp);
+            return;
+        }
+
+        // target linked-list is empty
+        if (!head) {
+            head = other.head;
+            tail = other.tail;
+            count = other.count;
+            other.head = other.tail = nullptr;
+            other.count = 0;
+            return;
+        }
+
+        // stable - on equal values nodes of this list come first
+        const Chain merged = mergeChains({ head, tail }, { other.head, other.tail }, comp);
+        head = merged.head;
+        tail = merged.tail;
+        count += other.count;
+        
+        // merging done
+        other.head = other.tail = nullptr;
+        other.count = 0;
+        debugCheckInvariants();
+    }
+
+    void merge(LinkedList& other, const DynamicOrdering& comp)
+    {
+        merge(other, std::cref(comp));
+    }
+
+    // set algebra on sorted lists, in place - kept nodes are relinked, discarded ones freed, other ends up empty
+    // duplicates count like in std::set_union and friends: a value m times here and n times in other is kept
+    // max(m, n) times by setUnion, min(m, n) by setIntersection, m - n by setDifference, |m - n| by setSymmetricDifference
+    // stretches of one list ordered before the head of the other are skipped by galloping once one side keeps winning,
+    // which costs O(log stretch) comparisons instead of one per node
+    template<ListOrdering<T> Compare = std::less<T>>
+    void setUnion(LinkedList& other, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "setUnion");
+        setOperation(other, comp, SetKind::Union);
+    }
+
+    void setUnion(LinkedList& other, const DynamicOrdering& comp)
+    {
+        setUnion(other, std::cref(comp));
+    }
+
+    template<ListOrdering<T> Compare = std::less<T>>
+    void setIntersection(LinkedList& other, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "setIntersection");
+        setOperation(other, comp, SetKind::Intersection);
+    }
+
+    void setIntersection(LinkedList& other, const DynamicOrdering& comp)
+    {
+        setIntersection(other, std::cref(comp));
+    }
+
+    // values of this list not matched in other
+    template<ListOrdering<T> Compare = std::less<T>>
+    void setDifference(LinkedList& other, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "setDifference");
+        setOperation(other, comp, SetKind::Difference);
+    }
+
+    void setDifference(LinkedList& other, const DynamicOrdering& comp)
+    {
+        setDifference(other, std::cref(comp));
+    }
+
+    template<ListOrdering<T> Compare = std::less<T>>
+    void setSymmetricDifference(LinkedList& other, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "setSymmetricDifference");
+        setOperation(other, comp, SetKind::SymmetricDifference);
+    }
+
+    void setSymmetricDifference(LinkedList& other, const DynamicOrdering& comp)
+    {
+        setSymmetricDifference(other, std::cref(comp));
+    }
+
+    // deduplicating merge - afterwards every value is in the list once, other ends up empty
+    template<ListOrdering<T> Compare = std::less<T>>
+    void mergeUnique(LinkedList& other, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "mergeUnique");
+        setOperation(other, comp, SetKind::Union);
+        unique(comp);
+    }
+
+    void mergeUnique(LinkedList& other, const DynamicOrdering& comp)
+    {
+        mergeUnique(other, std::cref(comp));
+    }
+
+    // drop every node equal to its predecessor, the list has to be sorted by comp
+    template<ListOrdering<T> Compare = std::less<T>>
+    void unique(Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "unique");
+        if (!head) return;
+        markModified();
+
+        ListNode* kept = head;
+        while (kept->next) {
+            Instrumentation::visited();
+            if (compare(comp, kept->val, kept->next->val)) kept = kept->next;
+            else unlinkAt(&kept->next);
+        }
+        tail = kept;
+        debugCheckInvariants();
+    }
+
+    void unique(const DynamicOrdering& comp)
+    {
+        unique(std::cref(comp));
+    }
+
+    // stable merge of two sorted chains - on equal values nodes of left come first
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static Chain mergeChains(Chain left, Chain right, Compare&& comp)
+    {
+        if (!left.head) return right;
+        if (!right.head) return left;
+
+        // fixed starting point of the merged chain
+        ListNode* mergedHead = nullptr;
+
+        // always points to the link after the last merged node
+        ListNode** last = &mergedHead;
+
+        ListNode* l1 = left.head;
+        ListNode* l2 = right.head;
+
+        while (l1 && l2) {
+            Instrumentation::visited();
+            // attach node to the last link
+            // move forward l1 / l2
+            if (compare(comp, l2->val, l1->val)) {
+                *last = l2;
+                l2 = l2->next;
+            }
+            else {
+                *last = l1;
+                l1 = l1->next;
+            }
+            // move last forward
+            last = &(*last)->next;
+        }
+
+        // attaching remaining elements
+        // the last node comes from whichever chain had elements left
+        *last = (l1) ? l1 : l2;
+        return { mergedHead, (l1) ? left.tail : right.tail };
+    }
+
+    // merge two sorted linked lists in an iterative fashion
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static ListNode* mergeIterative(ListNode* l1, ListNode* l2, Compare&& comp)
+    {
+        // if either list is empty, return the other list.
+        if (!l1) return l2;
+        if (!l2) return l1;
+
+        // ensure l1 is the smaller head
+        if (compare(comp, l2->val, l1->val)) std::swap(l1, l2);
+        ListNode* head = l1;
+
+        // traverse l1, inserting nodes from l2 in their correct positions
+        while (l1->next && l2) {
+            Instrumentation::visited();
+            // move the l2 node into l1
+            if (compare(comp, l2->val, l1->next->val))
+            {
+                ListNode* temp = l2;
+                l2 = l2->next;
+                temp->next = l1->next;
+                l1->next = temp;
+            }
+            l1 = l1->next;
+        }
+
+        // if l1 reaches the end, append remaining l2
+        if (!l1->next) l1->next = l2;
+        
+        return head;
+    }
+
+    // merge two sorted linked lists in a recursive fashion - GfG
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static ListNode* mergeRecursive(ListNode* l1, ListNode* l2, Compare&& comp)
+    {
+        // if either list is empty, return the other list
+        if (l1 == nullptr) return l2;
+        if (l2 == nullptr) return l1;
+        Instrumentation::visited();
+
+        // pick the smaller value between l1 and l2 nodes
+        if (compare(comp, l1->val, l2->val)) {
+
+            // recursively merge the rest of the lists
+            // and link the result to the current node
+            l1->next = mergeRecursive(l1->next, l2, comp);
+            return l1;
+        }
+        else {
+            // recursively merge the rest of the lists
+            // and link the result to the current node
+            l2->next = mergeRecursive(l1, l2->next, comp);
+            return l2;
+        }
+    }
+
+    // in-place k-way merge of other sorted linked-lists into this one, O(n log k)
+    // nodes are stolen like in merge, on equal values earlier lists come first (this list first of all)
+    template<ListOrdering<T> Compare = std::less<T>>
+    void mergeKWay(std::span<LinkedList> others, Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "mergeKWay");
+        const std::vector<Chain> chains = takeMergeInputs(others);
+        const Chain merged = mergeKWayChains(std::span<const Chain>(chains), comp);
+        head = merged.head;
+        tail = merged.tail;
+        debugCheckInvariants();
+    }
+
+    void mergeKWay(std::span<LinkedList> others, const DynamicOrdering& comp)
+    {
+        mergeKWay(others, std::cref(comp));
+    }
+
+    // k-way merge of sorted chains given by their first nodes, returns the first node of the merged chain
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static ListNode* mergeKWay(std::span<ListNode* const> heads, Compare&& comp)
+    {
+        // tails are unknown, the merged chain is only needed from its head
+        std::vector<Chain> chains;
+        chains.reserve(heads.size());
+        for (ListNode* node : heads) chains.push_back({ node, nullptr });
+        return mergeKWayChains(std::span<const Chain>(chains), comp).head;
+    }
+
+    // stable k-way merge of sorted chains with a loser tree (tournament tree)
+    // every node costs about log2(k) comparisons, ties go to the chain with the lower index
+    // once a single chain is left its remainder is spliced in one step
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static Chain mergeKWayChains(std::span<const Chain> chains, Compare&& comp)
+    {
+        const std::size_t k = chains.size();
+        if (k == 0) return {};
+        if (k == 1) return chains.front();
+
+        // front node of a chain together with the chain index, node is nullptr once the chain is drained
+        struct Entry {
+            ListNode* node;
+            std::size_t chain;
+        };
+
+        // true if a is ahead of b, drained chains lose against everything
+        // a single comparison decides, on equal values the lower chain index is ahead
+        auto ahead = [&comp](const Entry& a, const Entry& b) {
+            if (!a.node) return false;
+            if (!b.node) return true;
+            return a.chain < b.chain ? !compare(comp, b.node->val, a.node->val) : compare(comp, a.node->val, b.node->val);
+        };
+
+        // complete binary tree: leaves k..2k-1 stand for the chains, inner node i keeps the loser of its subtree match
+        std::size_t active = 0;
+        std::vector<Entry> losers(k);
+        std::vector<Entry> winners(2 * k);
+        for (std::size_t i = 0; i < k; ++i) {
+            winners[k + i] = { chains[i].head, i };
+            if (chains[i].head) ++active;
+        }
+        for (std::size_t node = k - 1; node >= 1; --node) {
+            const Entry& left = winners[2 * node];
+            const Entry& right = winners[2 * node + 1];
+            const bool leftWins = ahead(left, right);
+            winners[node] = leftWins ? left : right;
+            losers[node] = leftWins ? right : left;
+        }
+        Entry winner = winners[1];
+
+        Chain merged{};
+        ListNode** last = &merged.head;
+        while (active > 1) {
+            Instrumentation::visited();
+            ListNode* node = winner.node;
+            *last = node;
+            last = &node->next;
+            merged.tail = node;
+
+            winner.node = node->next;
+            if (!winner.node) --active;
+
+            // replay the matches on the path from the winner's leaf to the root
+            // outcomes of random keys are unpredictable, the swap is written as selects instead of a branch
+            for (std::size_t parent = (k + winner.chain) / 2; parent >= 1; parent /= 2) {
+                const Entry loser = losers[parent];
+                const bool loserAhead = ahead(loser, winner);
+                losers[parent] = loserAhead ? winner : loser;
+                winner = loserAhead ? loser : winner;
+            }
+        }
+
+        // the overall winner is the only chain with nodes left
+        *last = winner.node;
+        if (winner.node) merged.tail = chains[winner.chain].tail;
+        return merged;
+    }
+
+    // parallel k-way merge - same (stable) result as mergeKWay
+    // the key space is split by splitters sampled from all lists, every list is cut at the splitters concurrently
+    // and every key range is merged by its own task, the ranges are concatenated in order
+    // threads == 0 picks std::thread::hardware_concurrency()
+    template<ListOrdering<T> Compare = std::less<T>>
+    void parallelMergeKWay(std::span<LinkedList> others, Compare comp = Compare(), std::size_t threads = 0)
+    {
+        const Operation operation(instrumentation, "parallelMergeKWay");
+        if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        const std::vector<Chain> chains = takeMergeInputs(others);
+
+        // not worth a thread below this many nodes per key range
+        constexpr std::size_t minRange = std::size_t{ 1 } << 14;
+        threads = std::min(threads, count / minRange);
+        if (threads < 2) {
+            const Chain merged = mergeKWayChains(std::span<const Chain>(chains), comp);
+            head = merged.head;
+            tail = merged.tail;
+            debugCheckInvariants();
+            return;
+        }
+
+        const std::size_t k = chains.size();
+        const std::size_t ranges = threads;
+
+        // every list contributes samples in proportion to its length
+        constexpr std::size_t samplesPerRange = 32;
+        const std::size_t stride = std::max<std::size_t>(1, count / (ranges * samplesPerRange));
+        std::vector<std::vector<const ListNode*>> samples(threads);
+        runParallel(threads, comp, [&](std::size_t t, Compare&) {
+            for (std::size_t i = t; i < k; i += threads) {
+                std::size_t position = 0;
+                for (const ListNode* node = chains[i].head; node; node = node->next, ++position) {
+                    Instrumentation::visited();
+                    if (position % stride == stride / 2) samples[t].push_back(node);
+                }
+            }
+        });
+
+        std::vector<const ListNode*> sorted;
+        for (const auto& taskSamples : samples) sorted.insert(sorted.end(), taskSamples.begin(), taskSamples.end());
+        std::sort(sorted.begin(), sorted.end(), [&comp](const ListNode* a, const ListNode* b) { return compare(comp, a->val, b->val); });
+
+        // range r takes the values ordered before splitters[r] and not before splitters[r - 1]
+        std::vector<const ListNode*> splitters;
+        for (std::size_t r = 1; r < ranges && !sorted.empty(); ++r) splitters.push_back(sorted[sorted.size() * r / ranges]);
+
+        // pieces[i][r] - part of chain i falling into key range r
+        std::vector<std::vector<Chain>> pieces(k, std::vector<Chain>(splitters.size() + 1));
+        runParallel(threads, comp, [&](std::size_t t, Compare& localComp) {
+            for (std::size_t i = t; i < k; i += threads) {
+                std::size_t range = 0;
+                for (ListNode* node = chains[i].head; node; node = node->next) {
+                    Instrumentation::visited();
+                    while (range < splitters.size() && !compare(localComp, node->val, splitters[range]->val)) ++range;
+                    Chain& piece = pieces[i][range];
+                    if (piece.head) piece.tail->next = node;
+                    else piece.head = node;
+                    piece.tail = node;
+                }
+                for (Chain& piece : pieces[i]) {
+                    if (piece.tail) piece.tail->next = nullptr;
+                }
+            }
+        });
+
+        std::vector<Chain> merged(splitters.size() + 1);
+        runParallel(merged.size(), comp, [&](std::size_t r, Compare& localComp) {
+            std::vector<Chain> column(k);
+            for (std::size_t i = 0; i < k; ++i) column[i] = pieces[i][r];
+            merged[r] = mergeKWayChains(std::span<const Chain>(column), localComp);
+        });
+
+        Chain result{};
+        ListNode** last = &result.head;
+        for (const Chain& range : merged) {
+            if (!range.head) continue;
+            *last = range.head;
+            last = &range.tail->next;
+            result.tail = range.tail;
+        }
+        *last = nullptr;
+        head = result.head;
+        tail = result.tail;
+        debugCheckInvariants();
+    }
+
+    void parallelMergeKWay(std::span<LinkedList> others, const DynamicOrdering& comp, std::size_t threads = 0)
+    {
+        parallelMergeKWay(others, std::cref(comp), threads);
+    }
+    
+    // insertion sort
+    template<ListOrdering<T> Compare = std::less<T>>
+    void insertionSort(Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "insertionSort");
+        markModified();
+        ListNode* sorted = nullptr;
+        while (head) {
+            Instrumentation::visited();
+            ListNode* node = head;
+            head = head->next;
+            if (!sorted || compare(comp, node->val, sorted->val)) {
+                node->next = sorted;
+                sorted = node;
+            }
+            else {
+                ListNode* temp = sorted;
+                while (temp->next && !compare(comp, node->val, temp->next->val)) {
+                    Instrumentation::visited();
+                    temp = temp->next;
+                }
+                node->next = temp->next;
+                temp->next = node;
+            }
+        }
+        head = sorted;
+        resetTailAndCount();
+        debugCheckInvariants();
+    }
+
+    void insertionSort(const DynamicOrdering& comp)
+    {
+        insertionSort(std::cref(comp));
+    }
+
+    // bubble sort
+    template<ListOrdering<T> Compare = std::less<T>>
+    void bubbleSort(Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "bubbleSort");
+        if (!head || !head->next) return;
+        markModified();
+
+        bool swapped;
+        do {
+            swapped = false;
+            ListNode* current = head;
+            while (current->next) {
+                Instrumentation::visited();
+                if (compare(comp, current->next->val, current->val))
+                {
+                    std::swap(current->val, current->next->val);
+                    swapped = true;
+                }
+                current = current->next;
+            }
+        } while (swapped);
+    }
+
+    void bubbleSort(const DynamicOrdering& comp)
+    {
+        bubbleSort(std::cref(comp));
+    }
+
+    // merge sort
+    // stable bottom-up merge sort, no recursion
+    // integers with a standard ordering (std::less / std::greater) are radix sorted instead
+    template<ListOrdering<T> Compare = std::less<T>>
+    void mergeSort(Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "mergeSort");
+        if constexpr (RadixSortable<Compare, T>) {
+            radixSort(isStandardDescending<Compare, T>);
+            return;
+        }
+        markModified();
+        const Chain sorted = mergeSortInternal(head, comp);
+        head = sorted.head;
+        tail = sorted.tail;
+        debugCheckInvariants();
+    }
+
+    void mergeSort(const DynamicOrdering& comp)
+    {
+        mergeSort(std::cref(comp));
+    }
+
+    // stable radix sort for integers - nodes are relinked into per-digit bucket chains, values never move
+    void radixSort(bool descending = false) requires std::integral<T>
+    {
+        const Operation operation(instrumentation, "radixSort");
+        markModified();
+        const Chain sorted = radixSortInternal(head, descending);
+        head = sorted.head;
+        tail = sorted.tail;
+        debugCheckInvariants();
+    }
+
+    // radix sort helper
+    // keys are mapped to unsigned order: sign bit flipped for signed types, all bits flipped for descending order
+    static Chain radixSortInternal(ListNode* node, bool descending) requires std::integral<T>
+    {
+        if (!node || !node->next) return { node, node };
+
+        using Key = std::make_unsigned_t<T>;
+        constexpr Key signFlip = std::is_signed_v<T> ? Key(Key{ 1 } << (sizeof(T) * 8 - 1)) : Key{ 0 };
+        const Key flip = static_cast<Key>(signFlip ^ (descending ? static_cast<Key>(~Key{ 0 }) : Key{ 0 }));
+        auto keyOf = [flip](const T& v) { return static_cast<Key>(static_cast<Key>(v) ^ flip); };
+
+        const auto scan = scanKeys(node, keyOf);
+        return msdRadixSort({ node, scan.tail }, scan.size, scan.varying, keyOf);
+    }
+
+    // parallel merge sort - same (stable) result as mergeSort
+    // the chain is cut into one segment per thread, segments are sorted concurrently
+    // and then merged pairwise in parallel rounds with mergeChains
+    // threads == 0 picks std::thread::hardware_concurrency()
+    template<ListOrdering<T> Compare = std::less<T>>
+    void parallelMergeSort(Compare comp = Compare(), std::size_t threads = 0)
+    {
+        const Operation operation(instrumentation, "parallelMergeSort");
+        markModified();
+        if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        // not worth a thread below this many nodes per segment
+        constexpr std::size_t minSegment = std::size_t{ 1 } << 14;
+        threads = std::min(threads, count / minSegment);
+        if (threads < 2) {
+            mergeSort(comp);
+            return;
+        }
+
+        // cut into segments of nearly equal length, order of the segments is kept for stability
+        std::vector<Chain> segments;
+        segments.reserve(threads);
+        ListNode* node = head;
+        for (std::size_t s = 0; s < threads; ++s) {
+            const std::size_t length = count / threads + (s < count % threads ? 1 : 0);
+            Chain segment{ node, node };
+            for (std::size_t i = 1; i < length; ++i) segment.tail = segment.tail->next;
+            Instrumentation::visited(length);
+            node = segment.tail->next;
+            segment.tail->next = nullptr;
+            segments.push_back(segment);
+        }
+
+        runParallel(segments.size(), comp, [&segments](std::size_t s, Compare& localComp) {
+            segments[s] = mergeSortInternal(segments[s].head, localComp);
+        });
+
+        // merge neighbouring segments until one is left, left segment stays left
+        while (segments.size() > 1) {
+            const std::size_t pairs = segments.size() / 2;
+            std::vector<Chain> merged(pairs + segments.size() % 2);
+            runParallel(pairs, comp, [&segments, &merged](std::size_t p, Compare& localComp) {
+                merged[p] = mergeChains(segments[2 * p], segments[2 * p + 1], localComp);
+            });
+            if (segments.size() % 2) merged.back() = segments.back();
+            segments = std::move(merged);
+        }
+
+        head = segments.front().head;
+        tail = segments.front().tail;
+        debugCheckInvariants();
+    }
+
+    void parallelMergeSort(const DynamicOrdering& comp, std::size_t threads = 0)
+    {
+        parallelMergeSort(std::cref(comp), threads);
+    }
+
+    // adaptive natural merge sort (Timsort-style), stable
+    // - ascending and strictly descending runs are detected, descending runs are reversed in place
+    // - short runs are extended to minRun nodes by insertion
+    // - runs are merged under the Timsort stack invariants, merges switch to galloping
+    //   when one side keeps winning, so pre-sorted input costs close to n comparisons
+    template<ListOrdering<T> Compare = std::less<T>>
+    void adaptiveSort(Compare comp = Compare())
+    {
+        const Operation operation(instrumentation, "adaptiveSort");
+        if (!head || !head->next) return;
+        markModified();
+
+        const std::size_t minRun = computeMinRun(count);
+        std::size_t minGallop = initialMinGallop;
+
+        struct Run {
+            Chain chain;
+            std::size_t length;
+        };
+        std::vector<Run> runs;
+
+        auto mergeAt = [&](std::size_t i) {
+            runs[i].chain = mergeGalloping(runs[i].chain, runs[i + 1].chain, comp, minGallop);
+            runs[i].length += runs[i + 1].length;
+            runs.erase(runs.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        };
+
+        ListNode* node = head;
+        while (node) {
+            Instrumentation::visited();
+            Run run{ { node, node }, 1 };
+            node = node->next;
+
+            if (node && compare(comp, node->val, run.chain.tail->val)) {
+                // strictly descending - reversing keeps equal values in order because there are none
+                while (node && compare(comp, node->val, run.chain.tail->val)) {
+                    Instrumentation::visited();
+                    run.chain.tail = node;
+                    node = node->next;
+                    ++run.length;
+                }
+                run.chain.tail->next = nullptr;
+                run.chain.tail = run.chain.head;
+                run.chain.head = reverseChain(run.chain.head);
+            }
+            else {
+                while (node && !compare(comp, node->val, run.chain.tail->val)) {
+                    Instrumentation::visited();
+                    run.chain.tail = node;
+                    node = node->next;
+                    ++run.length;
+                }
+                run.chain.tail->next = nullptr;
+            }
+
+            // extend a short run by stable insertion
+            while (node && run.length < minRun) {
+                ListNode* next = node->next;
+                insertIntoRun(run.chain, node, comp);
+                node = next;
+                ++run.length;
+            }
+
+            runs.push_back(run);
+
+            // restore the run stack invariants
+            // runs[i - 1].length > runs[i].length + runs[i + 1].length and runs[i].length > runs[i + 1].length
+            while (runs.size() > 1) {
+                std::size_t i = runs.size() - 2;
+                if ((i >= 1 && runs[i - 1].length <= runs[i].length + runs[i + 1].length) ||
+                    (i >= 2 && runs[i - 2].length <= runs[i - 1].length + runs[i].length)) {
+                    if (runs[i - 1].length < runs[i + 1].length) --i;
+                }
+                else if (runs[i].length > runs[i + 1].length) {
+                    break;
+                }
+                mergeAt(i);
+            }
+        }
+
+        // collapse what is left on the stack
+        while (runs.size() > 1) {
+            std::size_t i = runs.size() - 2;
+            if (i > 0 && runs[i - 1].length < runs[i + 1].length) --i;
+            mergeAt(i);
+        }
+
+        head = runs.front().chain.head;
+        tail = runs.front().chain.tail;
+        debugCheckInvariants();
+    }
+
+    void adaptiveSort(const DynamicOrdering& comp)
+    {
+        adaptiveSort(std::cref(comp));
+    }
+
+    // stable merge of two sorted chains that gallops once one side wins minGallop times in a row
+    // galloping finds the end of a winning stretch with an exponential then binary probe
+    // and splices the whole stretch with a single link update
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static Chain mergeGalloping(Chain left, Chain right, Compare&& comp, std::size_t& minGallop)
+    {
+        if (!left.head) return right;
+        if (!right.head) return left;
+
+        ListNode* mergedHead = nullptr;
+        ListNode** last = &mergedHead;
+
+        ListNode* l1 = left.head;
+        ListNode* l2 = right.head;
+        std::size_t winsLeft = 0;
+        std::size_t winsRight = 0;
+
+        // move [first, end] of a chain behind the merged part
+        auto splice = [&last](ListNode*& first, ListNode* end) {
+            *last = first;
+            last = &end->next;
+            first = end->next;
+        };
+
+        while (l1 && l2) {
+            Instrumentation::visited();
+            if (compare(comp, l2->val, l1->val)) {
+                splice(l2, l2);
+                ++winsRight;
+                winsLeft = 0;
+            }
+            else {
+                splice(l1, l1);
+                ++winsLeft;
+                winsRight = 0;
+            }
+
+            if (winsLeft < minGallop && winsRight < minGallop) continue;
+
+            // galloping mode - stay while stretches are long
+            std::size_t takenLeft = 0;
+            std::size_t takenRight = 0;
+            do {
+                if (!l1 || !l2) break;
+
+                // left nodes not greater than the right head keep their place before it
+                const T& rightHead = l2->val;
+                if (ListNode* end = gallopLast(l1, [&](const T& v) { return !compare(comp, rightHead, v); }, takenLeft)) {
+                    splice(l1, end);
+                }
+                if (!l1) break;
+
+                // right nodes strictly less than the left head
+                const T& leftHead = l1->val;
+                if (ListNode* end = gallopLast(l2, [&](const T& v) { return compare(comp, v, leftHead); }, takenRight)) {
+                    splice(l2, end);
+                }
+
+                if (minGallop > 1) --minGallop;
+            } while (takenLeft >= initialMinGallop || takenRight >= initialMinGallop);
+
+            // leaving galloping mode costs
+            ++minGallop;
+            winsLeft = winsRight = 0;
+        }
+
+        // attaching remaining elements
+        *last = (l1) ? l1 : l2;
+        return { mergedHead, (l1) ? left.tail : right.tail };
+    }
+
+    // merge sort helper - bottom-up with a binary counter of runs
+    // runs[i] is empty or holds a sorted run of 2^i nodes, every new node is carried up like an increment
+    // extra space is the fixed array of runs, stack depth is constant
+    template<typename Compare> requires ListOrdering<std::remove_reference_t<Compare>, T>
+    static Chain mergeSortInternal(ListNode* node, Compare&& comp)
+    {
+        // if the list is empty or has only one node, it's already sorted
+        if (!node || !node->next) return { node, node };
+
+        constexpr std::size_t maxRuns = 64;
+        Chain runs[maxRuns] = {};
+        std::size_t usedRuns = 0;
+
+        while (node) {
+            Instrumentation::visited();
+            ListNode* next = node->next;
+            node->next = nullptr;
+
+            // runs[i] was built from earlier nodes than carry, it goes left to keep the sort stable
+            Chain carry{ node, node };
+            std::size_t i = 0;
+            for (; runs[i].head; ++i) {
+                carry = mergeChains(runs[i], carry, comp);
+                runs[i] = {};
+            }
+            runs[i] = carry;
+            usedRuns = std::max(usedRuns, i + 1);
+
+            node = next;
+        }
+
+        // fold the partial runs, higher runs are older
+        Chain sorted{};
+        for (std::size_t i = 0; i < usedRuns; ++i) {
+            if (runs[i].head) sorted = mergeChains(runs[i], sorted, comp);
+        }
+        return sorted;
+    }
+
+    // visit every value in list order
+    // Traversal::Prefetch overlaps the miss on the next node with fn on the current one, which only pays off for
+    // scattered nodes and enough work per node - a relinearized chain is streamed by the hardware prefetcher anyway
+    template<typename Fn>
+    void forEach(Fn&& fn, Traversal traversal = Traversal::Plain) const {
+        if (traversal == Traversal::Prefetch) {
+            for (const ListNode* node = head; node; node = node->next) {
+                if (node->next) prefetchRead(node->next);
+                fn(node->val);
+            }
+            return;
+        }
+        for (const ListNode* node = head; node; node = node->next) {
+            fn(node->val);
+        }
+    }
+
+    // display the linked list
+    void display(Traversal traversal = Traversal::Plain) const {
+        forEach([](const T& val) { std::cout << val << " -> "; }, traversal);
+        std::cout << "NULL" << std::endl;
+    }
+
+    // move the nodes into freshly allocated memory in list order, so traversals walk memory sequentially again
+    // after merges, deletions and sorts scattered them - the list object, its values and their order stay,
+    // node addresses change (pointers to nodes are invalidated)
+    // a propagating allocator (PoolAllocator) is replaced by a fresh one and the old pool is dropped as a whole,
+    // otherwise the nodes are reallocated from the same allocator in list order
+    // strong exception guarantee: every block is allocated before the first value is moved
+    void relinearize()
+    {
+        if (!head) return;
+        const Operation operation(instrumentation, "relinearize");
+        markModified();
+
+        NodeAllocator target = [this] {
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                return NodeAllocator(NodeTraits::select_on_container_copy_construction(alloc));
+            }
+            else {
+                return NodeAllocator(alloc);
+            }
+        }();
+
+        std::vector<ListNode*> blocks;
+        blocks.reserve(count);
+        try {
+            for (std::size_t i = 0; i < count; ++i) blocks.push_back(NodeTraits::allocate(target, 1));
+        }
+        catch (...) {
+            for (ListNode* block : blocks) NodeTraits::deallocate(target, block, 1);
+            throw;
+        }
+        Instrumentation::allocated(count);
+
+        // values are copied when moving them could throw, the list stays intact on failure
+        std::size_t constructed = 0;
+        try {
+            for (ListNode* node = head; node; node = node->next, ++constructed) {
+                Instrumentation::visited();
+                NodeTraits::construct(target, blocks[constructed], std::move_if_noexcept(node->val));
+            }
+        }
+        catch (...) {
+            for (std::size_t i = 0; i < blocks.size(); ++i) {
+                if (i < constructed) NodeTraits::destroy(target, blocks[i]);
+                NodeTraits::deallocate(target, blocks[i], 1);
+            }
+            throw;
+        }
+        for (std::size_t i = 0; i + 1 < blocks.size(); ++i) blocks[i]->next = blocks[i + 1];
+
+        const std::size_t nodes = count;
+        clear();
+        if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+            alloc = std::move(target);
+        }
+        head = blocks.front();
+        tail = blocks.back();
+        count = nodes;
+        debugCheckInvariants();
+    }
+
+    // copy a chain of nodes with the given allocator
+    static ListNode* deepCopy(ListNode* head, NodeAllocator& alloc) {
+        if (!head) return nullptr;
+        ListNode* newHead = NodeTraits::allocate(alloc, 1);
+        NodeTraits::construct(alloc, newHead, head->val);
+        Instrumentation::visited();
+        Instrumentation::allocated();
+        ListNode* current = newHead;
+        head = head->next;
+
+        while (head) {
+            current->next = NodeTraits::allocate(alloc, 1);
+            NodeTraits::construct(alloc, current->next, head->val);
+            Instrumentation::visited();
+            Instrumentation::allocated();
+            current = current->next;
+            head = head->next;
+        }
+        return newHead;
+    }
+
+    // operator overloading to merge two lists safely
+    // both operands are copied, the copies are merged
+    LinkedList operator+(const LinkedList& other) const& {
+        LinkedList result;
+        {
+            // recorded before result is returned
+            const Operation operation(result.instrumentation, "operator+");
+            ListNode* copy1 = deepCopy(this->head, result.alloc);
+            ListNode* copy2 = deepCopy(other.head, result.alloc);
+            result.head = mergeIterative(copy1, copy2, std::less<T>());
+            result.resetTailAndCount();
+        }
+        return result;
+    }
+
+    // rvalue operands are merged by relinking their nodes - no element is copied
+    LinkedList operator+(LinkedList&& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+
+    LinkedList operator+(const LinkedList& other) && {
+        LinkedList copy(other);
+        merge(copy);
+        return std::move(*this);
+    }
+
+    LinkedList operator+(LinkedList&& other) const& {
+        LinkedList result(*this);
+        result.merge(other);
+        return result;
+    }
+
+    // destructor to delete entire list
+    ~LinkedList() {
+        clear();
+    }
+
+private:
+    using Operation = typename Instrumentation::Operation;
+
+    // empty list on a copy of our node allocator - going through LinkedList(const Allocator&) would rebind it to T
+    // and back, which gives PoolAllocator a fresh pool both ways since the block sizes differ
+    struct SameNodes {};
+    LinkedList(SameNodes, const NodeAllocator& nodeAllocator) : head(nullptr), tail(nullptr), count(0), alloc(nodeAllocator) {}
+
+    // set operations sharing one walk (setOperation)
+    enum class SetKind {
+        Union,
+        Intersection,
+        Difference,
+        SymmetricDifference,
+    };
+
+    // walk both sorted chains, stretches only one list has and matched pairs are kept or dropped depending on kind
+    // nodes of other are only kept by union and symmetric difference - the other kinds leave its chain untouched,
+    // skip over it and clear it at the end (in bulk where the pool allows)
+    template<typename Compare>
+    void setOperation(LinkedList& other, Compare& comp, SetKind kind)
+    {
+        const bool keepOther = kind == SetKind::Union || kind == SetKind::SymmetricDifference;
+        if (this == &other) {
+            // every value is matched by itself
+            if (kind == SetKind::Difference || kind == SetKind::SymmetricDifference) clear();
+            return;
+        }
+        markModified();
+        other.markModified();
+
+        // nodes of the other list end up in this one, like in merge
+        if (keepOther && other.head && !adoptNodesOf(other)) {
+            LinkedList moved(SameNodes{}, alloc);
+            for (ListNode* node = other.head; node; node = node->next) {
+                Instrumentation::visited();
+                moved.insert(std::move(node->val));
+            }
+            other.clear();
+            setOperation(moved, comp, kind);
+            return;
+        }
+
+        std::size_t total = count + (keepOther ? other.count : 0);
+        Chain result{};
+        ListNode** last = &result.head;
+        auto keep = [&](ListNode* first, ListNode* end) {
+            *last = first;
+            last = &end->next;
+            result.tail = end;
+        };
+        auto discard = [&](ListNode* first, ListNode* end) {
+            while (true) {
+                ListNode* next = first->next;
+                const bool done = first == end;
+                freeNode(first);
+                --total;
+                if (done) break;
+                first = next;
+            }
+        };
+
+        // last node of a stretch ordered before limit starting at first, which is ordered before it already
+        // galloping only pays off once a side keeps winning, before that stretches are taken node by node
+        auto stretchEnd = [&](ListNode* first, const T& limit, std::size_t& wins) {
+            if (++wins < initialMinGallop) return first;
+            std::size_t taken = 0;
+            return gallopLast(first, [&](const T& v) { return compare(comp, v, limit); }, taken);
+        };
+
+        ListNode* a = head;
+        ListNode* b = other.head;
+        std::size_t winsA = 0;
+        std::size_t winsB = 0;
+        while (a && b) {
+            Instrumentation::visited();
+            if (compare(comp, a->val, b->val)) {
+                ListNode* end = stretchEnd(a, b->val, winsA);
+                winsB = 0;
+                ListNode* next = end->next;
+                if (kind == SetKind::Intersection) discard(a, end);
+                else keep(a, end);
+                a = next;
+            }
+            else if (compare(comp, b->val, a->val)) {
+                ListNode* end = stretchEnd(b, a->val, winsB);
+                winsA = 0;
+                ListNode* next = end->next;
+                if (keepOther) keep(b, end);
+                b = next;
+            }
+            else {
+                // one node of each list matches the other
+                winsA = winsB = 0;
+                ListNode* nextA = a->next;
+                ListNode* nextB = b->next;
+                if (kind == SetKind::Union || kind == SetKind::Intersection) keep(a, a);
+                else discard(a, a);
+                if (keepOther) discard(b, b);
+                a = nextA;
+                b = nextB;
+            }
+        }
+
+        if (a) {
+            if (kind == SetKind::Intersection) discard(a, tail);
+            else keep(a, tail);
+        }
+        if (b && keepOther) keep(b, other.tail);
+        *last = nullptr;
+
+        head = result.head;
+        tail = result.tail;
+        count = total;
+        if (keepOther) {
+            other.head = other.tail = nullptr;
+            other.count = 0;
+        }
+        else {
+            other.clear();
+        }
+        debugCheckInvariants();
+    }
+
+    static constexpr std::size_t initialMinGallop = 7;
+
+    // every comparator call of the sorts and merges goes through here, so instrumentation can count it
+    template<typename Compare>
+    static bool compare(Compare& comp, const T& a, const T& b)
+    {
+        Instrumentation::compared();
+        return comp(a, b);
+    }
+
+    // stable distribution of a chain into 256 bucket chains on one key byte, bucket tails are left linked to stale nodes
+    // size and varying bits of every bucket are collected on the way so no bucket has to be walked again before it is split
+    template<typename Key>
+    struct RadixBuckets {
+        static constexpr std::size_t radix = 256;
+
+        ListNode* heads[radix] = {};
+        ListNode* tails[radix];
+        std::size_t sizes[radix] = {};
+        Key anyOnes[radix] = {};
+        Key allOnes[radix];
+
+        template<typename KeyOf>
+        void distribute(ListNode* node, std::size_t shift, KeyOf keyOf) {
+            for (; node; node = node->next) {
+                Instrumentation::visited();
+                const Key key = keyOf(node->val);
+                const std::size_t digit = (key >> shift) & 0xFF;
+                if (heads[digit]) {
+                    tails[digit]->next = node;
+                    allOnes[digit] &= key;
+                }
+                else {
+                    heads[digit] = node;
+                    allOnes[digit] = key;
+                }
+                tails[digit] = node;
+                anyOnes[digit] |= key;
+                ++sizes[digit];
+            }
+        }
+
+        // bits in which at least two keys of a bucket differ
+        Key varying(std::size_t digit) const { return static_cast<Key>(anyOnes[digit] ^ allOnes[digit]); }
+    };
+
+    // buckets below this size are merge sorted on their keys
+    static constexpr std::size_t minRadixBucket = 256;
+
+    // buckets up to this size are LSD sorted - their scattered nodes stay resident in L2 across the passes
+    static constexpr std::size_t maxLsdBucket = std::size_t{ 1 } << 14;
+
+    template<typename Key>
+    struct KeyScan {
+        Key varying; // bits in which at least two keys differ
+        ListNode* tail;
+        std::size_t size;
+    };
+
+    template<typename KeyOf>
+    static auto scanKeys(ListNode* node, KeyOf keyOf)
+    {
+        using Key = decltype(keyOf(node->val));
+        KeyScan<Key> scan{ 0, node, 0 };
+        Key anyOnes = 0;
+        Key allOnes = static_cast<Key>(~Key{ 0 });
+        for (; node; node = node->next) {
+            Instrumentation::visited();
+            const Key key = keyOf(node->val);
+            anyOnes |= key;
+            allOnes &= key;
+            scan.tail = node;
+            ++scan.size;
+        }
+        scan.varying = static_cast<Key>(anyOnes ^ allOnes);
+        return scan;
+    }
+
+    // MSD split on the highest byte in which keys differ until buckets are small enough for LSD passes
+    // recursion depth is bounded by sizeof(Key)
+    template<typename KeyOf, typename Key>
+    static Chain msdRadixSort(Chain chain, std::size_t size, Key varying, KeyOf keyOf)
+    {
+        if (varying == 0) return chain;
+        if (size < minRadixBucket) {
+            return mergeSortInternal(chain.head, [&keyOf](const T& a, const T& b) { return keyOf(a) < keyOf(b); });
+        }
+        if (size <= maxLsdBucket) return lsdRadixSort(chain, varying, keyOf);
+
+        const std::size_t topShift = (std::bit_width(varying) - 1) / 8 * 8;
+        RadixBuckets<Key> buckets;
+        buckets.distribute(chain.head, topShift, keyOf);
+
+        Chain sorted{};
+        ListNode** last = &sorted.head;
+        for (std::size_t b = 0; b < RadixBuckets<Key>::radix; ++b) {
+            if (!buckets.heads[b]) continue;
+            buckets.tails[b]->next = nullptr;
+            const Chain part = msdRadixSort({ buckets.heads[b], buckets.tails[b] }, buckets.sizes[b], buckets.varying(b), keyOf);
+            *last = part.head;
+            last = &part.tail->next;
+            sorted.tail = part.tail;
+        }
+        *last = nullptr;
+        return sorted;
+    }
+
+    // one stable LSD pass per byte, bytes equal for every key are skipped
+    template<typename KeyOf, typename Key>
+    static Chain lsdRadixSort(Chain chain, Key varying, KeyOf keyOf)
+    {
+        for (std::size_t shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+            if (((varying >> shift) & 0xFF) == 0) continue;
+
+            RadixBuckets<Key> buckets;
+            buckets.distribute(chain.head, shift, keyOf);
+
+            // concatenate buckets in digit order
+            ListNode** last = &chain.head;
+            for (std::size_t b = 0; b < RadixBuckets<Key>::radix; ++b) {
+                if (!buckets.heads[b]) continue;
+                *last = buckets.heads[b];
+                last = &buckets.tails[b]->next;
+                chain.tail = buckets.tails[b];
+            }
+            *last = nullptr;
+        }
+        return chain;
+    }
+
+    // run length below which adaptiveSort extends runs by insertion, between 16 and 32 like Timsort
+    static std::size_t computeMinRun(std::size_t n)
+    {
+        std::size_t lowBits = 0;
+        while (n >= 32) {
+            lowBits |= n & 1;
+            n >>= 1;
+        }
+        return n + lowBits;
+    }
+
+    // stable insertion of a single node into a sorted chain, appending is checked first
+    template<typename Compare>
+    static void insertIntoRun(Chain& run, ListNode* node, Compare& comp)
+    {
+        if (!compare(comp, node->val, run.tail->val)) {
+            run.tail->next = node;
+            run.tail = node;
+            node->next = nullptr;
+            return;
+        }
+        ListNode** link = &run.head;
+        while (!compare(comp, node->val, (*link)->val)) {
+            Instrumentation::visited();
+            link = &(*link)->next;
+        }
+        node->next = *link;
+        *link = node;
+    }
+
+    // last node of the longest prefix of the chain starting at first for which pred holds (nullptr if none)
+    // pred has to be true for a prefix and false afterwards, comparisons are O(log taken)
+    template<typename Pred>
+    static ListNode* gallopLast(ListNode* first, Pred pred, std::size_t& taken)
+    {
+        taken = 0;
+        if (!pred(first->val)) return nullptr;
+
+        // exponential probe - good satisfies pred, bad (if any) does not
+        ListNode* good = first;
+        std::size_t goodIndex = 0;
+        std::size_t badIndex = 0;
+        for (std::size_t step = 1;; step *= 2) {
+            ListNode* probe = good;
+            std::size_t walked = 0;
+            while (walked < step && probe->next) {
+                probe = probe->next;
+                ++walked;
+            }
+            Instrumentation::visited(walked);
+            if (walked == 0) break;
+            if (!pred(probe->val)) {
+                badIndex = goodIndex + walked;
+                break;
+            }
+            good = probe;
+            goodIndex += walked;
+        }
+
+        // binary search between good and bad
+        while (badIndex > goodIndex + 1) {
+            const std::size_t half = (badIndex - goodIndex) / 2;
+            ListNode* mid = good;
+            for (std::size_t i = 0; i < half; ++i) mid = mid->next;
+            Instrumentation::visited(half);
+            if (pred(mid->val)) {
+                good = mid;
+                goodIndex += half;
+            }
+            else {
+                badIndex = goodIndex + half;
+            }
+        }
+
+        taken = goodIndex + 1;
+        return good;
+    }
+
+    // run task(t, comp) for t in [0, tasks) concurrently
+    // every task works on its own copy of the comparator, the first one runs on the calling thread
+    // every task counts into its own counters, they are joined into the calling operation once all tasks are done
+    template<typename Compare, typename Task>
+    static void runParallel(std::size_t tasks, const Compare& comp, Task&& task)
+    {
+        std::vector<OperationCounters> counters(Instrumentation::enabled ? tasks : 0);
+        auto counted = [&counters, &task](std::size_t t, Compare& localComp) {
+            if constexpr (Instrumentation::enabled) {
+                const typename Instrumentation::TaskScope scope(counters[t]);
+                task(t, localComp);
+            }
+            else {
+                task(t, localComp);
+            }
+        };
+
+        std::vector<std::future<void>> pending;
+        pending.reserve(tasks);
+        for (std::size_t t = 1; t < tasks; ++t) {
+            pending.push_back(std::async(std::launch::async, [t, localComp = Compare(comp), &counted]() mutable { counted(t, localComp); }));
+        }
+        Compare localComp = comp;
+        if (tasks > 0) counted(0, localComp);
+        for (auto& future : pending) future.get();
+        for (const OperationCounters& task : counters) Instrumentation::join(task);
+    }
+
+    // detach the chains of this list and of the others as inputs of a k-way merge, this list's chain first
+    // nodes of the others are adopted like in merge - if that is not possible their values are moved into our own nodes
+    // afterwards this list holds the total count but no chain, the others are empty
+    std::vector<Chain> takeMergeInputs(std::span<LinkedList> others)
+    {
+        markModified();
+        std::vector<Chain> chains;
+        chains.reserve(others.size() + 1);
+        chains.push_back({ head, tail });
+        std::size_t total = count;
+        auto take = [&](LinkedList& source) {
+            chains.push_back({ source.head, source.tail });
+            total += source.count;
+            source.head = source.tail = nullptr;
+            source.count = 0;
+        };
+
+        for (LinkedList& other : others) {
+            if (this == &other || !other.head) continue;
+
+            other.markModified();
+            if (adoptNodesOf(other)) {
+                take(other);
+                continue;
+            }
+
+            LinkedList moved(SameNodes{}, alloc);
+            for (ListNode* node = other.head; node; node = node->next) {
+                Instrumentation::visited();
+                moved.insert(std::move(node->val));
+            }
+            other.clear();
+            // moved allocates from a pool of its own when ours was moved away, take it over as well
+            adoptNodesOf(moved);
+            take(moved);
+        }
+
+        head = tail = nullptr;
+        count = total;
+        return chains;
+    }
+
+    // link node behind pos
+    iterator linkAfter(const_iterator pos, ListNode* node) {
+        markModified();
+        ListNode*& link = pos.nextLink();
+        node->next = link;
+        link = node;
+        if (!node->next) tail = node;
+        ++count;
+        debugCheckInvariants();
+        return iterator(node);
+    }
+
+    // skip and free the node *link points to
+    void unlinkAt(ListNode** link) {
+        ListNode* temp = *link;
+        *link = temp->next;
+        freeNode(temp);
+        --count;
+    }
+
+    // make the nodes of another list freeable through our allocator
+    bool adoptNodesOf(LinkedList& other) {
+        if (alloc == other.alloc) return true;
+        if constexpr (requires(NodeAllocator& a) { a.absorb(a); }) {
+            return alloc.absorb(other.alloc);
+        }
+        return false;
+    }
+
+    void debugCheckInvariants() const
+    {
+#if LINKEDLIST_CHECK_INVARIANTS
+        assert(checkInvariants());
+#endif
+    }
+};
+
+static_assert(std::ranges::forward_range<LinkedList<int>> && std::ranges::sized_range<LinkedList<int>>);
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+// instrumentation policies of LinkedList (third template parameter)
+// - a policy provides the counting hooks (visited, allocated, freed, compared) and an Operation scope
+// - LinkedList opens an Operation in every public bulk operation and calls the hooks from its loops and static helpers
+// - NoInstrumentation is the default, its hooks are empty and the list member holding it takes no space
+
+// counters of one operation, summed over its calls
+struct OperationCounters {
+    std::uint64_t calls = 0;
+    std::uint64_t visited = 0;
+    std::uint64_t allocated = 0;
+    std::uint64_t freed = 0;
+    std::uint64_t comparisons = 0;
+
+    OperationCounters& operator+=(const OperationCounters& other) {
+        calls += other.calls;
+        visited += other.visited;
+        allocated += other.allocated;
+        freed += other.freed;
+        comparisons += other.comparisons;
+        return *this;
+    }
+};
+
+// default policy - every hook compiles to nothing
+struct NoInstrumentation {
+    static constexpr bool enabled = false;
+
+    class Operation {
+    public:
+        constexpr Operation(NoInstrumentation&, std::string_view) {}
+    };
+
+    // counters a parallel task runs with, joined into the calling operation afterwards
+    class TaskScope {
+    public:
+        constexpr explicit TaskScope(OperationCounters&) {}
+    };
+
+    static constexpr void visited(std::size_t = 1) {}
+    static constexpr void allocated(std::size_t = 1) {}
+    static constexpr void freed(std::size_t = 1) {}
+    static constexpr void compared() {}
+    static constexpr void join(const OperationCounters&) {}
+};
+
+// per-operation counters of one list
+// - hooks count into the operation running on the calling thread, operations nested into it (a merge clearing
+//   the other list, a sort reversing runs) count towards the outermost one, hooks outside any operation are dropped
+// - parallel tasks count into their own counters, joined into the calling operation once the tasks are done
+// - every hook costs a thread-local lookup, every operation a map update at its end
+class CountingInstrumentation {
+public:
+    static constexpr bool enabled = true;
+
+    // counts the hooks called while it lives into the operation name, unless an operation is running already
+    // only the outermost operation of a thread counts, so its counters live in one slot per thread
+    class Operation {
+    public:
+        Operation(CountingInstrumentation& owner, std::string_view name) : owner(owner), name(name) {
+            if (!running()) {
+                outermostCounters() = {};
+                running() = &outermostCounters();
+            }
+            else {
+                outermost = false;
+            }
+        }
+
+        Operation(const Operation&) = delete;
+        Operation& operator=(const Operation&) = delete;
+
+        ~Operation() {
+            if (!outermost) return;
+            running() = nullptr;
+            OperationCounters& counters = outermostCounters();
+            counters.calls = 1;
+            owner.operations[name] += counters;
+        }
+
+    private:
+        CountingInstrumentation& owner;
+        std::string_view name;
+        bool outermost = true;
+    };
+
+    // redirects the hooks of the calling thread to the counters of one parallel task
+    class TaskScope {
+    public:
+        explicit TaskScope(OperationCounters& counters) : previous(std::exchange(running(), &counters)) {}
+
+        TaskScope(const TaskScope&) = delete;
+        TaskScope& operator=(const TaskScope&) = delete;
+
+        ~TaskScope() { running() = previous; }
+
+    private:
+        OperationCounters* previous;
+    };
+
+    static void visited(std::size_t nodes = 1) {
+        if (OperationCounters* counters = running()) counters->visited += nodes;
+    }
+
+    static void allocated(std::size_t nodes = 1) {
+        if (OperationCounters* counters = running()) counters->allocated += nodes;
+    }
+
+    static void freed(std::size_t nodes = 1) {
+        if (OperationCounters* counters = running()) counters->freed += nodes;
+    }
+
+    static void compared() {
+        if (OperationCounters* counters = running()) ++counters->comparisons;
+    }
+
+    // add the counters of a finished parallel task to the operation running on this thread
+    static void join(const OperationCounters& task) {
+        if (OperationCounters* counters = running()) {
+            const std::uint64_t calls = counters->calls;
+            *counters += task;
+            counters->calls = calls;
+        }
+    }
+
+    // totals by operation name, names are string literals
+    const std::map<std::string_view, OperationCounters>& totals() const { return operations; }
+
+    void reset() { operations.clear(); }
+
+    // { "operation": { "calls": ..., "visited": ..., "allocated": ..., "freed": ..., "comparisons": ... }, ... }
+    void writeJson(std::ostream& out) const {
+        out << "{";
+        const char* separator = "\n";
+        for (const auto& [name, counters] : operations) {
+            out << separator << "  \"" << name << "\": { \"calls\": " << counters.calls << ", \"visited\": " << counters.visited
+                << ", \"allocated\": " << counters.allocated << ", \"freed\": " << counters.freed
+                << ", \"comparisons\": " << counters.comparisons << " }";
+            separator = ",\n";
+        }
+        out << (operations.empty() ? "}" : "\n}") << std::endl;
+    }
+
+private:
+    // counters of the operation running on the calling thread, nullptr outside of operations
+    static OperationCounters*& running() {
+        thread_local OperationCounters* counters = nullptr;
+        return counters;
+    }
+
+    // counters of the outermost operation on the calling thread - thread storage rather than the Operation object,
+    // so running() never points into a stack frame
+    static OperationCounters& outermostCounters() {
+        thread_local OperationCounters counters;
+        return counters;
+    }
+
+    std::map<std::string_view, OperationCounters> operations;
+};
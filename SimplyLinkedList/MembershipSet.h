@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "NoUniqueAddress.h"
+
+// membership tests for bulk deletion (LinkedList::deleteValues)
+// the backend is picked from the delete set itself:
+// - dense bitmap when the values are integers from a compact range
+// - open-addressing flat hash set when the values are hashable
+// - binary search over the sorted values otherwise
+
+enum class MembershipKind {
+    Sorted,
+    Bitmap,
+    Hash,
+};
+
+inline const char* membershipKindName(MembershipKind kind)
+{
+    switch (kind) {
+    case MembershipKind::Bitmap: return "bitmap";
+    case MembershipKind::Hash: return "hash";
+    default: return "sorted";
+    }
+}
+
+template<typename T>
+concept BitmapMember = std::integral<T> && !std::same_as<T, bool>;
+
+template<typename T>
+concept HashMember = std::default_initializable<T> && std::copyable<T> && std::equality_comparable<T> &&
+    requires(const T& value) { { std::hash<T>{}(value) } -> std::convertible_to<std::size_t>; };
+
+// sorted unique values, binary search per lookup
+template<typename T>
+class SortedMembers {
+public:
+    explicit SortedMembers(std::span<const T> sorted) : values(sorted) {}
+
+    bool contains(const T& value) const {
+        return std::binary_search(values.begin(), values.end(), value);
+    }
+
+private:
+    std::span<const T> values;
+};
+
+// one bit per value of [low, high]
+template<BitmapMember T>
+class DenseBitmap {
+public:
+    // a bitmap is used while it needs at most this many bits per member (8 bytes per member at 64)
+    static constexpr std::uint64_t maxBitsPerMember = 64;
+
+    // sorted has to be sorted and non-empty
+    static bool fits(std::span<const T> sorted) {
+        return span(sorted.front(), sorted.back()) / maxBitsPerMember < sorted.size();
+    }
+
+    explicit DenseBitmap(std::span<const T> sorted)
+        : low(sorted.front()), bits(span(sorted.front(), sorted.back()) + 1), words((bits + 63) / 64)
+    {
+        for (const T& value : sorted) {
+            const std::uint64_t offset = offsetOf(value);
+            words[offset / 64] |= std::uint64_t{ 1 } << (offset % 64);
+        }
+    }
+
+    bool contains(const T& value) const {
+        // values below low wrap around to large offsets
+        const std::uint64_t offset = offsetOf(value);
+        return offset < bits && (words[offset / 64] >> (offset % 64)) & 1;
+    }
+
+private:
+    using Key = std::make_unsigned_t<T>;
+
+    static std::uint64_t span(T low, T high) {
+        return static_cast<Key>(static_cast<Key>(high) - static_cast<Key>(low));
+    }
+
+    std::uint64_t offsetOf(T value) const {
+        return static_cast<Key>(static_cast<Key>(value) - static_cast<Key>(low));
+    }
+
+    T low;
+    std::uint64_t bits;
+    std::vector<std::uint64_t> words;
+};
+
+// open addressing with linear probing, at most half of the slots are used
+// hashes are scrambled with a Fibonacci multiplier since std::hash of integers is usually the identity
+template<HashMember T, typename Hash = std::hash<T>>
+class FlatHashSet {
+public:
+    // values have to be unique
+    explicit FlatHashSet(std::span<const T> values)
+        : slots(std::bit_ceil(std::max<std::size_t>(16, values.size() * 2)))
+        , shift(64 - std::countr_zero(slots.size()))
+    {
+        for (const T& value : values) {
+            std::size_t slot = slotOf(value);
+            while (slots[slot].used) slot = (slot + 1) & (slots.size() - 1);
+            slots[slot] = { value, true };
+        }
+    }
+
+    bool contains(const T& value) const {
+        for (std::size_t slot = slotOf(value); slots[slot].used; slot = (slot + 1) & (slots.size() - 1)) {
+            if (slots[slot].value == value) return true;
+        }
+        return false;
+    }
+
+private:
+    struct Slot {
+        T value{};
+        bool used = false;
+    };
+
+    std::size_t slotOf(const T& value) const {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash(value)) * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    std::vector<Slot> slots;
+    int shift;
+    LINKEDLIST_NO_UNIQUE_ADDRESS Hash hash;
+};
+
+// backend that withMembershipSet picks for a sorted, unique and non-empty set of values
+template<typename T>
+MembershipKind chooseMembership(std::span<const T> sorted)
+{
+    if constexpr (BitmapMember<T>) {
+        if (DenseBitmap<T>::fits(sorted)) return MembershipKind::Bitmap;
+    }
+    if constexpr (HashMember<T>) {
+        return MembershipKind::Hash;
+    }
+    return MembershipKind::Sorted;
+}
+
+// build the chosen backend for sorted (sorted, unique, non-empty) and call fn(set)
+// every backend offers bool contains(const T&) const, fn is instantiated once per backend
+template<typename T, typename Fn>
+void withMembershipSet(std::span<const T> sorted, Fn&& fn)
+{
+    switch (chooseMembership(sorted)) {
+    case MembershipKind::Bitmap:
+        if constexpr (BitmapMember<T>) {
+            fn(DenseBitmap<T>(sorted));
+            return;
+        }
+        break;
+    case MembershipKind::Hash:
+        if constexpr (HashMember<T>) {
+            fn(FlatHashSet<T>(sorted));
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    fn(SortedMembers<T>(sorted));
+}
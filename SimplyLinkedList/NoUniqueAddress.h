@@ -0,0 +1,11 @@
+#pragma once
+
+// [[no_unique_address]] for members that are usually empty (comparators, hashes, instrumentation policies)
+// MSVC accepts the standard attribute but ignores it to keep its ABI, only its own spelling lets the member overlap
+#ifndef LINKEDLIST_NO_UNIQUE_ADDRESS
+#ifdef _MSC_VER
+#define LINKEDLIST_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define LINKEDLIST_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// slab allocator for fixed-size blocks (list nodes)
+// - blocks are carved out of geometrically growing chunks, one malloc per chunk
+// - freed blocks are kept in an intrusive free-list and recycled
+// - every chunk is released in bulk on release() / destruction
+class NodePool {
+public:
+    static constexpr std::size_t firstChunkBlocks = 64;
+    static constexpr std::size_t maxChunkBlocks = std::size_t{ 1 } << 16;
+
+    NodePool(std::size_t size, std::size_t align)
+        : blockSize(roundUp(std::max(size, sizeof(FreeBlock)), std::max(align, alignof(FreeBlock))))
+        , blockAlign(std::max(align, alignof(FreeBlock)))
+    {
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        release();
+    }
+
+    // hand out one uninitialized block
+    void* allocate() {
+        if (freeList) {
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            if (!freeList) freeListTail = nullptr;
+            return block;
+        }
+        if (bumpCurrent == bumpEnd) {
+            grow();
+        }
+        void* block = bumpCurrent;
+        bumpCurrent += blockSize;
+        return block;
+    }
+
+    // return a block to the free-list, memory stays owned by the pool
+    void deallocate(void* p) noexcept {
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeList;
+        if (!freeList) freeListTail = block;
+        freeList = block;
+    }
+
+    // free every chunk at once - blocks handed out earlier become invalid
+    void release() noexcept {
+        while (chunks) {
+            ChunkHeader* prev = chunks->prev;
+            ::operator delete(static_cast<void*>(chunks), std::align_val_t{ chunkAlign() });
+            chunks = prev;
+        }
+        oldestChunk = nullptr;
+        freeList = freeListTail = nullptr;
+        chunkCount = 0;
+        bumpCurrent = bumpEnd = nullptr;
+        nextChunkBlocks = firstChunkBlocks;
+    }
+
+    // take over all chunks of another pool with the same block layout
+    // used when nodes are stolen from another list (in-place merge)
+    void absorb(NodePool& other) noexcept {
+        assert(blockSize == other.blockSize && blockAlign == other.blockAlign);
+        if (this == &other) return;
+
+        // blocks left in the other pool's bump region are recycled through the free-list
+        while (other.bumpCurrent != other.bumpEnd) {
+            other.deallocate(other.bumpCurrent);
+            other.bumpCurrent += other.blockSize;
+        }
+
+        if (other.chunks) {
+            other.oldestChunk->prev = chunks;
+            if (!chunks) oldestChunk = other.oldestChunk;
+            chunks = other.chunks;
+        }
+        if (other.freeList) {
+            other.freeListTail->next = freeList;
+            if (!freeList) freeListTail = other.freeListTail;
+            freeList = other.freeList;
+        }
+
+        chunkCount += other.chunkCount;
+        other.chunks = other.oldestChunk = nullptr;
+        other.freeList = other.freeListTail = nullptr;
+        other.bumpCurrent = other.bumpEnd = nullptr;
+        other.chunkCount = 0;
+        other.nextChunkBlocks = firstChunkBlocks;
+    }
+
+    // number of chunks currently held by this pool
+    std::size_t ownedChunks() const { return chunkCount; }
+
+    // number of chunk mallocs issued by all pools
+    static std::size_t totalChunkAllocations() { return totalChunks.load(std::memory_order_relaxed); }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct ChunkHeader {
+        ChunkHeader* prev;
+    };
+
+    static std::size_t roundUp(std::size_t value, std::size_t align) {
+        return (value + align - 1) / align * align;
+    }
+
+    std::size_t chunkAlign() const {
+        return std::max(blockAlign, alignof(ChunkHeader));
+    }
+
+    void grow() {
+        // header is padded so the first block keeps its alignment
+        const std::size_t headerSize = roundUp(sizeof(ChunkHeader), chunkAlign());
+        const std::size_t bytes = headerSize + nextChunkBlocks * blockSize;
+        void* raw = ::operator new(bytes, std::align_val_t{ chunkAlign() });
+
+        ChunkHeader* chunk = static_cast<ChunkHeader*>(raw);
+        chunk->prev = chunks;
+        if (!chunks) oldestChunk = chunk;
+        chunks = chunk;
+
+        bumpCurrent = static_cast<std::byte*>(raw) + headerSize;
+        bumpEnd = bumpCurrent + nextChunkBlocks * blockSize;
+
+        ++chunkCount;
+        totalChunks.fetch_add(1, std::memory_order_relaxed);
+        nextChunkBlocks = std::min(nextChunkBlocks * 2, maxChunkBlocks);
+    }
+
+    std::size_t blockSize;
+    std::size_t blockAlign;
+
+    // newest chunk first, oldest chunk kept for O(1) absorb
+    ChunkHeader* chunks = nullptr;
+    ChunkHeader* oldestChunk = nullptr;
+    FreeBlock* freeList = nullptr;
+    FreeBlock* freeListTail = nullptr;
+    std::byte* bumpCurrent = nullptr;
+    std::byte* bumpEnd = nullptr;
+
+    std::size_t nextChunkBlocks = firstChunkBlocks;
+    std::size_t chunkCount = 0;
+
+    inline static std::atomic<std::size_t> totalChunks{ 0 };
+};
+
+// allocator handing out single objects from a shared NodePool
+// - copies share the pool and compare equal, a default constructed allocator owns a fresh pool
+// - a container copy gets its own pool (select_on_container_copy_construction)
+// - array allocations (n > 1) go straight to operator new
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    PoolAllocator() : pool(makePool()) {}
+
+    // rebinding shares the pool only if the block layout matches, otherwise the rebound allocator gets its own pool
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other)
+        : pool(sizeof(U) == sizeof(T) && alignof(U) == alignof(T) && other.pool ? other.pool : makePool())
+    {
+    }
+
+    PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+
+    T* allocate(std::size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+        }
+        // a moved-from allocator starts over with a fresh pool
+        if (!pool) pool = makePool();
+        return static_cast<T*>(pool->allocate());
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(static_cast<void*>(p), std::align_val_t{ alignof(T) });
+            return;
+        }
+        pool->deallocate(p);
+    }
+
+    // take over the memory behind another allocator's objects so they can be relinked into our container
+    // only possible when the other pool is not shared with anybody else
+    bool absorb(PoolAllocator& other) {
+        if (pool == other.pool || !other.pool) return true;
+        if (other.pool.use_count() != 1) return false;
+
+        if (!pool) pool = makePool();
+        pool->absorb(*other.pool);
+        return true;
+    }
+
+    // free every object at once - only possible when nobody else shares the pool
+    bool releaseAll() noexcept {
+        if (!pool) return true;
+        if (pool.use_count() != 1) return false;
+
+        pool->release();
+        return true;
+    }
+
+    // chunks held by the pool behind this allocator
+    std::size_t ownedChunks() const { return pool ? pool->ownedChunks() : 0; }
+
+    friend bool operator==(const PoolAllocator& lhs, const PoolAllocator& rhs) {
+        return lhs.pool == rhs.pool;
+    }
+
+private:
+    template<typename U>
+    friend class PoolAllocator;
+
+    static std::shared_ptr<NodePool> makePool() {
+        return std::make_shared<NodePool>(sizeof(T), alignof(T));
+    }
+
+    std::shared_ptr<NodePool> pool;
+};
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "LinkedList.h"
+
+// on-disk linked-list format
+// - a header followed by nodes of { value, next }, next is the byte offset of the following node in the file (0 ends the list)
+// - the file is used in place through a read-only memory mapping, values are never deserialized
+// - nodes may be stored in any order, compactListFile rewrites them in traversal order
+// - values have to be trivially copyable, the byte order is the one of the writing machine (checked on open)
+
+struct ListFileHeader {
+    static constexpr char expectedMagic[8] = { 'S', 'L', 'L', 'I', 'S', 'T', '\0', '\x01' };
+    static constexpr std::uint32_t currentVersion = 1;
+    static constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t nodeSize;
+    std::uint32_t nodeAlign;
+    std::uint32_t valueSize;
+    std::uint32_t valueAlign;
+    std::uint64_t count;
+
+    // offsets of the first and the last node, 0 for an empty list
+    std::uint64_t head;
+    std::uint64_t tail;
+};
+
+template<typename T>
+struct ListFileNode {
+    T val;
+    std::uint64_t next;
+};
+
+// offset of the first node slot - the header is padded so every node keeps its alignment
+template<typename T>
+constexpr std::uint64_t listFileFirstNode()
+{
+    constexpr std::uint64_t align = alignof(ListFileNode<T>);
+    return (sizeof(ListFileHeader) + align - 1) / align * align;
+}
+
+// read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping)
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) fail("cannot open", path);
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) fail("cannot stat", path);
+        bytes = static_cast<std::size_t>(fileSize.QuadPart);
+        if (bytes > 0) {
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) fail("cannot map", path);
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!view) fail("cannot map", path);
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) fail("cannot open", path);
+        struct stat status {};
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            fail("cannot stat", path);
+        }
+        bytes = static_cast<std::size_t>(status.st_size);
+        if (bytes > 0) {
+            view = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) {
+                view = nullptr;
+                ::close(fd);
+                fail("cannot map", path);
+            }
+        }
+        // the mapping keeps the file alive
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : view(std::exchange(other.view, nullptr)), bytes(std::exchange(other.bytes, 0))
+#ifdef _WIN32
+        , file(std::exchange(other.file, INVALID_HANDLE_VALUE)), mapping(std::exchange(other.mapping, nullptr))
+#endif
+    {
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    const std::byte* data() const { return static_cast<const std::byte*>(view); }
+    std::size_t size() const { return bytes; }
+
+private:
+    void unmap() noexcept {
+#ifdef _WIN32
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (view) ::munmap(view, bytes);
+#endif
+        view = nullptr;
+        bytes = 0;
+    }
+
+    [[noreturn]] void fail(const char* what, const std::filesystem::path& path) {
+        unmap();
+        throw std::runtime_error(std::string(what) + " list file " + path.string());
+    }
+
+    void* view = nullptr;
+    std::size_t bytes = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+// read-only view of a list file, traversed directly in the mapping
+template<typename T>
+class MappedList {
+    static_assert(std::is_trivially_copyable_v<T>, "list files store values as raw bytes");
+
+public:
+    using Node = ListFileNode<T>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return node->val; }
+        pointer operator->() const { return &node->val; }
+
+        const_iterator& operator++() {
+            node = list->follow(node, index);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.node == rhs.node; }
+
+    private:
+        friend class MappedList;
+
+        const_iterator(const MappedList* list, const Node* node) : list(list), node(node) {}
+
+        const MappedList* list = nullptr;
+        const Node* node = nullptr;
+
+        // position of node in the list, bounds the walk by the node count
+        std::uint64_t index = 0;
+    };
+
+    // throws std::runtime_error if the file cannot be mapped or was not written for T on this kind of machine
+    explicit MappedList(const std::filesystem::path& path) : file(path) {
+        if (file.size() < sizeof(ListFileHeader)) invalid(path, "truncated header");
+        std::memcpy(&header, file.data(), sizeof(ListFileHeader));
+
+        if (std::memcmp(header.magic, ListFileHeader::expectedMagic, sizeof(header.magic)) != 0) invalid(path, "not a list file");
+        if (header.version != ListFileHeader::currentVersion) invalid(path, "unsupported version");
+        if (header.byteOrder != ListFileHeader::byteOrderMark) invalid(path, "foreign byte order");
+        if (header.nodeSize != sizeof(Node) || header.nodeAlign != alignof(Node) || header.valueSize != sizeof(T) || header.valueAlign != alignof(T)) {
+            invalid(path, "written for another value type");
+        }
+        const std::uint64_t slots = file.size() > listFileFirstNode<T>() ? (file.size() - listFileFirstNode<T>()) / sizeof(Node) : 0;
+        if (header.count > slots) invalid(path, "more nodes than the file holds");
+        if (!validOffset(header.head) || !validOffset(header.tail)) invalid(path, "head or tail out of range");
+    }
+
+    std::size_t size() const { return static_cast<std::size_t>(header.count); }
+    bool empty() const { return header.count == 0; }
+
+    // bytes of the mapped file
+    std::size_t fileSize() const { return file.size(); }
+
+    const_iterator begin() const { return { this, first() }; }
+    const_iterator end() const { return { this, nullptr }; }
+
+    // display the linked list
+    void display() const {
+        for (const T& val : *this) std::cout << val << " -> ";
+        std::cout << "NULL" << std::endl;
+    }
+
+    // whether every node directly follows its predecessor in the file, i.e. a traversal streams the file
+    bool isSequential() const {
+        std::uint64_t expected = header.head;
+        std::uint64_t index = 0;
+        for (const Node* node = first(); node; node = follow(node, index)) {
+            if (offsetOf(node) != expected) return false;
+            expected += sizeof(Node);
+        }
+        return true;
+    }
+
+private:
+    [[noreturn]] static void invalid(const std::filesystem::path& path, const char* reason) {
+        throw std::runtime_error("invalid list file " + path.string() + ": " + reason);
+    }
+
+    // written without offset + sizeof(Node), which wraps around for offsets close to 2^64
+    bool validOffset(std::uint64_t offset) const {
+        return offset == 0 ||
+            (offset >= listFileFirstNode<T>() && file.size() >= sizeof(Node) && offset <= file.size() - sizeof(Node) &&
+             (offset - listFileFirstNode<T>()) % alignof(Node) == 0);
+    }
+
+    // node at a byte offset, nullptr for 0 - a link leaving the file throws instead of reading out of bounds
+    const Node* nodeAt(std::uint64_t offset) const {
+        if (offset == 0) return nullptr;
+        if (!validOffset(offset)) throw std::runtime_error("corrupt list file: link out of range");
+        return reinterpret_cast<const Node*>(file.data() + offset);
+    }
+
+    const Node* first() const {
+        const Node* node = nodeAt(header.head);
+        if (node && header.count == 0) throw std::runtime_error("corrupt list file: more nodes than its node count");
+        if (!node && header.count != 0) throw std::runtime_error("corrupt list file: fewer nodes than its node count");
+        return node;
+    }
+
+    // successor of the node at position index, a chain longer (e.g. a cycle) or shorter than the node count throws
+    const Node* follow(const Node* node, std::uint64_t& index) const {
+        const Node* next = nodeAt(node->next);
+        if (next && ++index >= header.count) throw std::runtime_error("corrupt list file: more nodes than its node count");
+        if (!next && index + 1 != header.count) throw std::runtime_error("corrupt list file: fewer nodes than its node count");
+        return next;
+    }
+
+    std::uint64_t offsetOf(const Node* node) const {
+        return static_cast<std::uint64_t>(reinterpret_cast<const std::byte*>(node) - file.data());
+    }
+
+    MappedFile file;
+    ListFileHeader header{};
+};
+
+namespace listFileDetail {
+
+// write the count values of [first, last) in traversal order - node i is stored in slot i and links to slot i + 1
+template<typename T, typename Iterator>
+void writeSequential(const std::filesystem::path& path, std::uint64_t count, Iterator first, Iterator last)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "list files store values as raw bytes");
+    using Node = ListFileNode<T>;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot create list file " + path.string());
+
+    const std::uint64_t firstNode = listFileFirstNode<T>();
+
+    ListFileHeader header{};
+    std::memcpy(header.magic, ListFileHeader::expectedMagic, sizeof(header.magic));
+    header.version = ListFileHeader::currentVersion;
+    header.byteOrder = ListFileHeader::byteOrderMark;
+    header.nodeSize = sizeof(Node);
+    header.nodeAlign = alignof(Node);
+    header.valueSize = sizeof(T);
+    header.valueAlign = alignof(T);
+    header.count = count;
+    header.head = count ? firstNode : 0;
+    header.tail = count ? firstNode + (count - 1) * sizeof(Node) : 0;
+
+    // header and padding up to the first node
+    std::vector<std::byte> block(firstNode);
+    std::memcpy(block.data(), &header, sizeof(header));
+    out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+
+    // nodes are staged in blocks
+    constexpr std::size_t nodesPerBlock = 4096;
+    block.resize(nodesPerBlock * sizeof(Node));
+    for (std::uint64_t written = 0; written < count;) {
+        const std::size_t batch = static_cast<std::size_t>(std::min<std::uint64_t>(nodesPerBlock, count - written));
+        for (std::size_t i = 0; i < batch; ++i, ++first, ++written) {
+            if (first == last) throw std::runtime_error("list ended before its node count while writing " + path.string());
+
+            // padding bytes are written as zeros
+            Node node;
+            std::memset(static_cast<void*>(&node), 0, sizeof(Node));
+            node.val = *first;
+            node.next = written + 1 < count ? firstNode + (written + 1) * sizeof(Node) : 0;
+            std::memcpy(block.data() + i * sizeof(Node), &node, sizeof(Node));
+        }
+        out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(batch * sizeof(Node)));
+    }
+
+    if (!out.flush()) throw std::runtime_error("cannot write list file " + path.string());
+}
+
+template<typename T>
+class ListValueIterator {
+public:
+    explicit ListValueIterator(const ListNode<T>* node) : node(node) {}
+    const T& operator*() const { return node->val; }
+    ListValueIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+    friend bool operator==(const ListValueIterator& lhs, const ListValueIterator& rhs) { return lhs.node == rhs.node; }
+
+private:
+    const ListNode<T>* node;
+};
+
+} // namespace listFileDetail
+
+// save a list, nodes are stored in traversal order
+template<typename T, typename Allocator, typename Instrumentation>
+void saveList(const LinkedList<T, Allocator, Instrumentation>& list, const std::filesystem::path& path)
+{
+    using Iterator = listFileDetail::ListValueIterator<T>;
+    listFileDetail::writeSequential<T>(path, list.size(), Iterator(list.head), Iterator(nullptr));
+}
+
+// build a list from a file - values are copied straight out of the mapping, nothing is parsed
+template<typename T, typename Allocator = PoolAllocator<T>, typename Instrumentation = NoInstrumentation>
+LinkedList<T, Allocator, Instrumentation> loadList(const std::filesystem::path& path, const Allocator& allocator = Allocator())
+{
+    const MappedList<T> mapped(path);
+    LinkedList<T, Allocator, Instrumentation> list(allocator);
+    for (const T& val : mapped) list.insert(val);
+    return list;
+}
+
+// rewrite a list file in traversal order so iterating it streams the file sequentially, unreachable nodes are dropped
+// the compacted file is written next to the original and renamed over it
+template<typename T>
+void compactListFile(const std::filesystem::path& path)
+{
+    std::filesystem::path compacted = path;
+    compacted += ".compact";
+    {
+        const MappedList<T> mapped(path);
+        listFileDetail::writeSequential<T>(compacted, mapped.size(), mapped.begin(), mapped.end());
+    }
+    // the mapping is closed here - required before replacing the file on Windows
+    std::filesystem::rename(compacted, path);
+}
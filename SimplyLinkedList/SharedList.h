@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+#include "LinkedList.h"
+
+// copy-on-write singly-linked list - copies share their node chains
+// - every node counts the links pointing at it (list heads and predecessor nodes), copies only bump the head's count
+// - a mutation copies the prefix up to the last node it modifies, the rest of the chain stays shared
+// - operator+ copies the merged prefix and shares whatever is left of the input that lasts longer
+// - counts are atomic, so lists sharing nodes may live on different threads (one list per thread, as usual)
+template<typename T>
+class SharedList {
+public:
+    struct Node {
+        T val;
+        Node* next;
+        std::atomic<std::size_t> refs;
+    };
+
+    SharedList() = default;
+
+    // O(1), both lists share the chain until one of them writes
+    SharedList(const SharedList& other) : head(other.head), tail(other.tail), count(other.count), exclusive(false) {
+        acquire(head);
+        other.exclusive.store(false, std::memory_order_relaxed);
+    }
+
+    SharedList(SharedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)), count(std::exchange(other.count, 0)),
+          exclusive(other.exclusive.load(std::memory_order_relaxed)) {
+    }
+
+    // copy of the values of a LinkedList, not shared with anything
+    template<typename Allocator, typename Instrumentation>
+    explicit SharedList(const LinkedList<T, Allocator, Instrumentation>& list) {
+        for (auto* node = list.head; node; node = node->next) insert(node->val);
+    }
+
+    SharedList& operator=(SharedList other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~SharedList() {
+        release(head);
+    }
+
+    void swap(SharedList& other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+        const bool ours = exclusive.load(std::memory_order_relaxed);
+        exclusive.store(other.exclusive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.exclusive.store(ours, std::memory_order_relaxed);
+    }
+
+    std::size_t size() const { return count; }
+
+    // number of nodes at the end of the chain that are shared with other lists
+    std::size_t sharedNodes() const {
+        std::size_t position = 0;
+        for (const Node* node = head; node; node = node->next, ++position) {
+            if (node->refs.load(std::memory_order_acquire) != 1) return count - position;
+        }
+        return 0;
+    }
+
+    // visit every value in list order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Node* node = head; node; node = node->next) fn(node->val);
+    }
+
+    // values copied into a plain LinkedList, e.g. to run the algorithms only LinkedList has
+    template<typename Allocator = PoolAllocator<T>, typename Instrumentation = NoInstrumentation>
+    LinkedList<T, Allocator, Instrumentation> toLinkedList() const {
+        LinkedList<T, Allocator, Instrumentation> list;
+        forEach([&list](const T& val) { list.insert(val); });
+        return list;
+    }
+
+    // insert at the end - copies the whole chain if it is shared
+    // the chain is owned before the node is made, so a copy throwing on the way leaks nothing
+    void insert(const T& val) {
+        Node** end = isExclusive() ? (tail ? &tail->next : &head) : ownLink(count).link;
+        tail = *end = new Node{ val, nullptr, 1 };
+        ++count;
+    }
+
+    // insert at the front - O(1), the old chain stays shared as the new node's tail
+    void pushFront(const T& val) {
+        head = new Node{ val, head, 1 };
+        if (!tail) tail = head;
+        ++count;
+    }
+
+    // delete all nodes with a specific value, nodes behind the last match stay shared
+    void deleteValue(const T& val) {
+        std::size_t last = count;
+        std::size_t position = 0;
+        for (const Node* node = head; node; node = node->next, ++position) {
+            if (node->val == val) last = position;
+        }
+        if (last == count) return;
+
+        ownLink(last);
+        Node** link = &head;
+        Node* prev = nullptr;
+        for (std::size_t i = 0; i <= last; ++i) {
+            if ((*link)->val == val) unlinkAt(link);
+            else link = &(prev = *link)->next;
+        }
+        if (!*link) tail = prev;
+    }
+
+    // delete the node at position size() / 2, the nodes behind it stay shared
+    void deleteMiddleNode() {
+        if (!head) return;
+
+        const Position middle = ownLink(count / 2);
+        unlinkAt(middle.link);
+        if (!*middle.link) tail = middle.prev;
+    }
+
+    void reverseIterative() {
+        ownLink(count);
+        Node* prev = nullptr;
+        Node* node = head;
+        while (node) {
+            Node* next = node->next;
+            node->next = prev;
+            prev = node;
+            node = next;
+        }
+        tail = head;
+        head = prev;
+    }
+
+    // stable bottom-up merge sort, a shared chain is copied first
+    template<ListOrdering<T> Compare = std::less<T>>
+    void mergeSort(Compare comp = Compare()) {
+        if (count < 2) return;
+        ownLink(count);
+
+        constexpr std::size_t maxRuns = 64;
+        Chain runs[maxRuns] = {};
+        std::size_t usedRuns = 0;
+
+        Node* node = head;
+        while (node) {
+            Node* next = node->next;
+            node->next = nullptr;
+
+            // runs[i] was built from earlier nodes than carry, it goes left to keep the sort stable
+            Chain carry{ node, node };
+            std::size_t i = 0;
+            for (; runs[i].head; ++i) {
+                carry = mergeChains(runs[i], carry, comp);
+                runs[i] = {};
+            }
+            runs[i] = carry;
+            usedRuns = std::max(usedRuns, i + 1);
+
+            node = next;
+        }
+
+        Chain sorted{};
+        for (std::size_t i = 0; i < usedRuns; ++i) {
+            if (runs[i].head) sorted = mergeChains(runs[i], sorted, comp);
+        }
+        head = sorted.head;
+        tail = sorted.tail;
+    }
+
+    // stable merge of another sorted list, which ends up empty
+    // exclusively owned nodes are relinked, otherwise the merged prefix is copied and the rest shared
+    template<ListOrdering<T> Compare = std::less<T>>
+    void merge(SharedList& other, Compare comp = Compare()) {
+        if (this == &other || !other.head) return;
+
+        if (isExclusive() && other.isExclusive()) {
+            const Chain merged = mergeChains({ head, tail }, { other.head, other.tail }, comp);
+            head = merged.head;
+            tail = merged.tail;
+            count += other.count;
+            other.head = other.tail = nullptr;
+            other.count = 0;
+            return;
+        }
+
+        SharedList merged = mergedCopy(*this, other, comp);
+        swap(merged);
+        other = SharedList();
+    }
+
+    // merge of two sorted lists, both operands stay untouched
+    friend SharedList operator+(const SharedList& lhs, const SharedList& rhs) {
+        return mergedCopy(lhs, rhs, std::less<T>());
+    }
+
+    void display() const {
+        forEach([](const T& val) { std::cout << val << " -> "; });
+        std::cout << "NULL" << std::endl;
+    }
+
+private:
+    // detached run of nodes [head, tail]
+    struct Chain {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+    };
+
+    static void acquire(Node* node) {
+        if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // drop one link to node, nodes nobody links to any more are deleted along the chain
+    static void release(Node* node) {
+        while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // link to the node at some position and the node holding that link (nullptr for the head)
+    struct Position {
+        Node** link;
+        Node* prev;
+    };
+
+    // every node before position is copied unless this list is the only one linking to it
+    // returns the link pointing at the node at position (at the end of the chain for position == size())
+    Position ownLink(std::size_t position) {
+        Node** link = &head;
+        Node* prev = nullptr;
+        std::size_t i = 0;
+        const bool known = isExclusive();
+        for (; i < position && (known || (*link)->refs.load(std::memory_order_acquire) == 1); ++i) {
+            prev = *link;
+            link = &prev->next;
+        }
+        if (i == position) {
+            if (position == count) exclusive.store(true, std::memory_order_relaxed);
+            return { link, prev };
+        }
+
+        // every node behind a shared one is reachable from another list as well, the rest of the prefix is copied
+        // into a detached chain first, so a failing copy leaves the list untouched
+        Node* shared = *link;
+        Node* original = shared;
+        Node* copies = nullptr;
+        Node** end = &copies;
+        try {
+            for (; i < position; ++i, original = original->next) {
+                prev = new Node{ original->val, nullptr, 1 };
+                *end = prev;
+                end = &prev->next;
+            }
+        }
+        catch (...) {
+            release(copies);
+            throw;
+        }
+
+        // the copied prefix links to the first node left shared, the list lets go of the first copied one
+        acquire(original);
+        *end = original;
+        *link = copies;
+        release(shared);
+        if (!original) tail = prev;
+
+        if (position == count) exclusive.store(true, std::memory_order_relaxed);
+        return { end, prev };
+    }
+
+    // nodes added to an exclusive chain, or a chain nobody else copied, need no reference walk
+    bool isExclusive() const {
+        return exclusive.load(std::memory_order_relaxed);
+    }
+
+    // unlink the node *link points to, its successor keeps the link of the removed node
+    void unlinkAt(Node** link) {
+        Node* node = *link;
+        *link = node->next;
+        acquire(node->next);
+        release(node);
+        --count;
+    }
+
+    template<typename Compare>
+    static Chain mergeChains(Chain left, Chain right, Compare& comp) {
+        if (!left.head) return right;
+        if (!right.head) return left;
+
+        Node* mergedHead = nullptr;
+        Node** last = &mergedHead;
+        Node* l1 = left.head;
+        Node* l2 = right.head;
+        while (l1 && l2) {
+            if (comp(l2->val, l1->val)) {
+                *last = l2;
+                l2 = l2->next;
+            }
+            else {
+                *last = l1;
+                l1 = l1->next;
+            }
+            last = &(*last)->next;
+        }
+        *last = l1 ? l1 : l2;
+        return { mergedHead, l1 ? left.tail : right.tail };
+    }
+
+    // copies of the merged prefix followed by the shared rest of the longer lasting input
+    template<typename Compare>
+    static SharedList mergedCopy(const SharedList& lhs, const SharedList& rhs, Compare comp) {
+        SharedList result;
+        Node** last = &result.head;
+        const Node* a = lhs.head;
+        const Node* b = rhs.head;
+        while (a && b) {
+            const Node*& taken = comp(b->val, a->val) ? b : a;
+            Node* copy = new Node{ taken->val, nullptr, 1 };
+            *last = copy;
+            last = &copy->next;
+            result.tail = copy;
+            taken = taken->next;
+        }
+
+        const SharedList& rest = a ? lhs : rhs;
+        Node* shared = const_cast<Node*>(a ? a : b);
+        if (shared) {
+            acquire(shared);
+            *last = shared;
+            result.tail = rest.tail;
+            result.exclusive.store(false, std::memory_order_relaxed);
+            rest.exclusive.store(false, std::memory_order_relaxed);
+        }
+        result.count = lhs.count + rhs.count;
+        return result;
+    }
+
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    std::size_t count = 0;
+
+    // no other list links to any node of this chain, cleared whenever the chain gets shared
+    mutable std::atomic<bool> exclusive{ true };
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "LinkedList.h"
+#include "NodePool.h"
+#include "NoUniqueAddress.h"
+
+// probabilistic skip-list index over a sorted LinkedList
+// - the list itself is the bottom level, a node gets an index tower of height h with probability 4^-h
+// - every index level is a chain of towers (list node, right, down) carved out of a NodePool
+// - lookups descend to the last indexed node ordered before the value and finish on the list
+// - find, lowerBound, insert and erase keep the index in sync, any other change of the list
+//   (LinkedList::modifications moved, e.g. a merge) rebuilds the index on its next use
+template<typename T, typename Allocator = PoolAllocator<T>, typename Compare = std::less<T>, typename Instrumentation = NoInstrumentation>
+class SkipListIndex {
+public:
+    using List = LinkedList<T, Allocator, Instrumentation>;
+    using ListNode = typename List::ListNode;
+
+    // 4^16 nodes before the top level gets crowded
+    static constexpr std::size_t maxLevels = 16;
+
+    // list has to be sorted by comp and has to outlive the index
+    explicit SkipListIndex(List& list, Compare comp = Compare(), std::uint64_t seed = 0x9E3779B97F4A7C15ull)
+        : list(list), comp(std::move(comp)), pool(sizeof(Tower), alignof(Tower)), rng(seed | 1)
+    {
+        for (std::size_t level = 1; level < maxLevels; ++level) heads[level].down = &heads[level - 1];
+    }
+
+    // towers point into the header array
+    SkipListIndex(const SkipListIndex&) = delete;
+    SkipListIndex& operator=(const SkipListIndex&) = delete;
+
+    // first node not ordered before value, nullptr if there is none
+    ListNode* lowerBound(const T& value) {
+        ListNode* prev = descend([this, &value](const T& x) { return comp(x, value); }, nullptr);
+        return prev ? prev->next : list.head;
+    }
+
+    // first node equal to value, nullptr if there is none
+    ListNode* find(const T& value) {
+        ListNode* node = lowerBound(value);
+        return node && !comp(value, node->val) ? node : nullptr;
+    }
+
+    // insert value behind the nodes equal to it, the list stays sorted
+    ListNode* insert(const T& value) {
+        std::array<Tower*, maxLevels> update;
+        ListNode* prev = descend([this, &value](const T& x) { return !comp(value, x); }, &update);
+
+        ListNode* node = list.newNode(value);
+        ListNode*& link = prev ? prev->next : list.head;
+        node->next = link;
+        link = node;
+        if (!node->next) list.tail = node;
+        ++list.count;
+
+        const std::size_t height = randomHeight();
+        for (std::size_t level = levels; level < height; ++level) update[level] = &heads[level];
+        levels = std::max(levels, height);
+
+        Tower* below = nullptr;
+        for (std::size_t level = 0; level < height; ++level) {
+            below = new (pool.allocate()) Tower{ node, update[level]->right, below };
+            update[level]->right = below;
+        }
+
+        synced();
+        return node;
+    }
+
+    // erase the nodes in [low, high), returns the number of erased nodes
+    std::size_t erase(const T& low, const T& high) {
+        return eraseFrom(low, [this, &high](const T& x) { return comp(x, high); });
+    }
+
+    // erase every node equal to value
+    std::size_t erase(const T& value) {
+        return eraseFrom(value, [this, &value](const T& x) { return !comp(value, x); });
+    }
+
+    // build the index from scratch in O(n)
+    void rebuild() {
+        pool.release();
+        for (Tower& head : heads) head.right = nullptr;
+        levels = 0;
+
+        std::array<Tower*, maxLevels> last;
+        for (std::size_t level = 0; level < maxLevels; ++level) last[level] = &heads[level];
+
+        for (ListNode* node = list.head; node; node = node->next) {
+            assert(!node->next || !comp(node->next->val, node->val));
+
+            const std::size_t height = randomHeight();
+            levels = std::max(levels, height);
+
+            Tower* below = nullptr;
+            for (std::size_t level = 0; level < height; ++level) {
+                below = new (pool.allocate()) Tower{ node, nullptr, below };
+                last[level]->right = below;
+                last[level] = below;
+            }
+        }
+
+        builtAt = list.modifications;
+        built = true;
+    }
+
+    // the list changed behind the index, the next operation rebuilds it
+    bool stale() const {
+        return !built || builtAt != list.modifications;
+    }
+
+    // number of towers on every index level, lowest level first
+    std::vector<std::size_t> levelSizes() {
+        refresh();
+        std::vector<std::size_t> sizes;
+        for (std::size_t level = 0; level < levels; ++level) {
+            std::size_t towers = 0;
+            for (const Tower* tower = heads[level].right; tower; tower = tower->right) ++towers;
+            sizes.push_back(towers);
+        }
+        return sizes;
+    }
+
+private:
+    // one level of a node's tower, header towers have no node
+    struct Tower {
+        ListNode* node = nullptr;
+        Tower* right = nullptr;
+        Tower* down = nullptr;
+    };
+
+    void refresh() {
+        if (stale()) rebuild();
+    }
+
+    // an index operation changed the list, other indexes over it have to rebuild
+    void synced() {
+        list.markModified();
+        builtAt = list.modifications;
+    }
+
+    // xorshift64*, two trailing zero bits per level
+    std::size_t randomHeight() {
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        const std::uint64_t bits = rng * 0x2545F4914F6CDD1Dull;
+        return static_cast<std::size_t>(std::countr_zero(bits | (std::uint64_t{ 1 } << (2 * maxLevels)))) / 2;
+    }
+
+    // last list node for which before holds, nullptr if it does not hold for the head
+    // update receives the last tower passed on every level (a header tower if none)
+    template<typename Before>
+    ListNode* descend(Before before, std::array<Tower*, maxLevels>* update) {
+        refresh();
+
+        ListNode* prev = nullptr;
+        Tower* tower = levels ? &heads[levels - 1] : nullptr;
+        for (std::size_t level = levels; level-- > 0; tower = tower->down) {
+            while (tower->right && before(tower->right->node->val)) tower = tower->right;
+            if (update) (*update)[level] = tower;
+            if (tower->node) prev = tower->node;
+        }
+
+        // at most a few unindexed nodes are left to the target
+        ListNode* node = prev ? prev->next : list.head;
+        while (node && before(node->val)) {
+            prev = node;
+            node = node->next;
+        }
+        return prev;
+    }
+
+    // erase the run of nodes starting at the first node not ordered before low and satisfying inRange
+    template<typename InRange>
+    std::size_t eraseFrom(const T& low, InRange inRange) {
+        std::array<Tower*, maxLevels> update;
+        ListNode* prev = descend([this, &low](const T& x) { return comp(x, low); }, &update);
+
+        // towers first, they still read the values of their nodes
+        for (std::size_t level = 0; level < levels; ++level) {
+            Tower* tower = update[level];
+            while (tower->right && inRange(tower->right->node->val)) {
+                Tower* erased = tower->right;
+                tower->right = erased->right;
+                pool.deallocate(erased);
+            }
+        }
+        while (levels && !heads[levels - 1].right) --levels;
+
+        std::size_t erased = 0;
+        ListNode** link = prev ? &prev->next : &list.head;
+        while (*link && inRange((*link)->val)) {
+            ListNode* node = *link;
+            *link = node->next;
+            list.freeNode(node);
+            ++erased;
+        }
+        if (!*link) list.tail = prev;
+        list.count -= erased;
+
+        if (erased) synced();
+        return erased;
+    }
+
+    List& list;
+    LINKEDLIST_NO_UNIQUE_ADDRESS Compare comp;
+
+    // header tower of every level, heads[level].down is the header one level below
+    std::array<Tower, maxLevels> heads{};
+
+    // index levels in use
+    std::size_t levels = 0;
+
+    NodePool pool;
+    std::uint64_t rng;
+
+    // list modifications the index is in sync with
+    std::uint64_t builtAt = 0;
+    bool built = false;
+};
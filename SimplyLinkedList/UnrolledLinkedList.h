@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#include "LinkedList.h"
+#include "MembershipSet.h"
+#include "NodePool.h"
+
+// unrolled list node - a cache line holding a block of values
+struct alignas(64) UnrolledNode {
+    static constexpr std::size_t cacheLine = 64;
+    static constexpr std::size_t capacity = (cacheLine - sizeof(void*) - sizeof(std::uint32_t)) / sizeof(int);
+
+    UnrolledNode* next = nullptr;
+    std::uint32_t count = 0;
+    int values[capacity];
+
+    bool full() const { return count == capacity; }
+};
+
+static_assert(sizeof(UnrolledNode) == UnrolledNode::cacheLine, "an unrolled node has to fill exactly one cache line");
+
+// unrolled singly-linked list - same operations as LinkedList, but every hop visits a block of values
+class UnrolledLinkedList {
+public:
+    UnrolledNode* head;
+    UnrolledNode* tail;
+
+    // number of values (not blocks)
+    std::size_t count;
+
+    // every block of the list lives in this pool
+    NodePool pool;
+
+    UnrolledLinkedList() : head(nullptr), tail(nullptr), count(0), pool(sizeof(UnrolledNode), alignof(UnrolledNode)) {}
+
+    UnrolledLinkedList(const UnrolledLinkedList& other) : UnrolledLinkedList() {
+        copyFrom(other);
+    }
+
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other) {
+        if (this == &other) return *this; // handle self-assignment
+
+        clear();
+        copyFrom(other);
+        return *this;
+    }
+
+    ~UnrolledLinkedList() {
+        clear();
+    }
+
+    std::size_t size() const { return count; }
+
+    // number of blocks in the chain
+    std::size_t blocks() const {
+        std::size_t blockCount = 0;
+        for (const UnrolledNode* node = head; node; node = node->next) ++blockCount;
+        return blockCount;
+    }
+
+    // visit every value in list order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const UnrolledNode* node = head; node; node = node->next) {
+            for (std::uint32_t i = 0; i < node->count; ++i) {
+                fn(node->values[i]);
+            }
+        }
+    }
+
+    // insert at the end
+    void insert(int val) {
+        if (!tail || tail->full()) {
+            appendBlock(newBlock());
+        }
+        tail->values[tail->count++] = val;
+        ++count;
+    }
+
+    // delete all values equal to val
+    void deleteValue(int val) {
+        removeIf([val](int x) { return x == val; });
+    }
+
+    // delete all values contained in values
+    void deleteValues(std::vector<int>& values) {
+        if (!head) return;
+
+        std::vector<int> deleteSet(values.begin(), values.end());
+        std::sort(deleteSet.begin(), deleteSet.end());
+        deleteSet.erase(std::unique(deleteSet.begin(), deleteSet.end()), deleteSet.end());
+        if (deleteSet.empty()) return;
+
+        withMembershipSet(std::span<const int>(deleteSet), [this](const auto& members) {
+            removeIf([&members](int x) { return members.contains(x); });
+        });
+    }
+
+    // reverse the block chain and the values inside every block
+    void reverse() {
+        UnrolledNode* prev = nullptr;
+        UnrolledNode* current = head;
+        while (current) {
+            UnrolledNode* next = current->next;
+            std::reverse(current->values, current->values + current->count);
+            current->next = prev;
+            prev = current;
+            current = next;
+        }
+        tail = head;
+        head = prev;
+    }
+
+    // in-place merge another sorted list
+    // values are streamed into fresh blocks while consumed blocks are recycled through the pool
+    template<ListOrdering<int> Compare = std::less<int>>
+    void merge(UnrolledLinkedList& other, Compare comp = Compare()) {
+        if (!other.head || this == &other) return;
+
+        // blocks of the other list are consumed here - take over the memory backing them
+        pool.absorb(other.pool);
+
+        Run merged = mergeRuns({ head, tail }, { other.head, other.tail }, comp);
+        head = merged.head;
+        tail = merged.tail;
+        count += other.count;
+
+        other.head = other.tail = nullptr;
+        other.count = 0;
+    }
+
+    // insertion sort - whole blocks are skipped by comparing against their last value
+    template<ListOrdering<int> Compare = std::less<int>>
+    void insertionSort(Compare comp = Compare()) {
+        UnrolledNode* unsorted = head;
+        head = tail = nullptr;
+        count = 0;
+
+        while (unsorted) {
+            UnrolledNode* node = unsorted;
+            unsorted = unsorted->next;
+            for (std::uint32_t i = 0; i < node->count; ++i) {
+                insertSorted(node->values[i], comp);
+            }
+            freeBlock(node);
+        }
+    }
+
+    // bottom-up merge sort
+    // every block is sorted locally, then runs of blocks are merged like a binary counter
+    template<ListOrdering<int> Compare = std::less<int>>
+    void mergeSort(Compare comp = Compare()) {
+        if (!head) return;
+
+        // runs[i] holds a sorted run of 2^i blocks (or is empty)
+        std::array<Run, 64> runs{};
+
+        UnrolledNode* node = head;
+        while (node) {
+            UnrolledNode* next = node->next;
+            node->next = nullptr;
+            std::stable_sort(node->values, node->values + node->count, std::ref(comp));
+
+            Run carry{ node, node };
+            std::size_t level = 0;
+            while (runs[level].head) {
+                carry = mergeRuns(runs[level], carry, comp);
+                runs[level] = {};
+                ++level;
+            }
+            runs[level] = carry;
+
+            node = next;
+        }
+
+        // fold remaining runs, older (lower level is newer) runs come first
+        Run result{};
+        for (const Run& run : runs) {
+            if (!run.head) continue;
+            result = result.head ? mergeRuns(run, result, comp) : run;
+        }
+        head = result.head;
+        tail = result.tail;
+    }
+
+    // display the list
+    void display() const {
+        forEach([](int val) { std::cout << val << " -> "; });
+        std::cout << "NULL" << std::endl;
+    }
+
+private:
+    // chain of blocks [head, tail]
+    struct Run {
+        UnrolledNode* head = nullptr;
+        UnrolledNode* tail = nullptr;
+    };
+
+    UnrolledNode* newBlock() {
+        return new (pool.allocate()) UnrolledNode;
+    }
+
+    void freeBlock(UnrolledNode* node) {
+        node->~UnrolledNode();
+        pool.deallocate(node);
+    }
+
+    void appendBlock(UnrolledNode* node) {
+        if (tail) tail->next = node;
+        else head = node;
+        tail = node;
+    }
+
+    void clear() {
+        head = tail = nullptr;
+        count = 0;
+        pool.release();
+    }
+
+    void copyFrom(const UnrolledLinkedList& other) {
+        for (const UnrolledNode* node = other.head; node; node = node->next) {
+            UnrolledNode* copy = newBlock();
+            std::copy(node->values, node->values + node->count, copy->values);
+            copy->count = node->count;
+            appendBlock(copy);
+        }
+        count = other.count;
+    }
+
+    // compact every block in place, drop empty blocks and fold a block into its predecessor when both fit
+    template<typename Pred>
+    void removeIf(Pred pred) {
+        UnrolledNode* prev = nullptr;
+        UnrolledNode* node = head;
+        while (node) {
+            std::uint32_t kept = 0;
+            for (std::uint32_t i = 0; i < node->count; ++i) {
+                if (!pred(node->values[i])) node->values[kept++] = node->values[i];
+            }
+            count -= node->count - kept;
+            node->count = kept;
+
+            UnrolledNode* next = node->next;
+            if (prev && prev->count + node->count <= UnrolledNode::capacity) {
+                std::copy(node->values, node->values + node->count, prev->values + prev->count);
+                prev->count += node->count;
+                prev->next = next;
+                freeBlock(node);
+            }
+            else if (node->count == 0) {
+                // prev is nullptr here, node is the head block
+                head = next;
+                freeBlock(node);
+            }
+            else {
+                prev = node;
+            }
+            node = next;
+        }
+        tail = prev;
+    }
+
+    // insert a single value into the sorted chain [head, tail]
+    template<typename Compare>
+    void insertSorted(int val, Compare& comp) {
+        ++count;
+
+        // find the first block whose last value is ordered after val
+        UnrolledNode* node = head;
+        while (node && !comp(val, node->values[node->count - 1])) node = node->next;
+
+        if (!node) {
+            if (!tail || tail->full()) appendBlock(newBlock());
+            tail->values[tail->count++] = val;
+            return;
+        }
+
+        // split a full block in half before inserting
+        if (node->full()) {
+            UnrolledNode* upper = newBlock();
+            const std::uint32_t half = node->count / 2;
+            std::copy(node->values + half, node->values + node->count, upper->values);
+            upper->count = node->count - half;
+            node->count = half;
+            upper->next = node->next;
+            node->next = upper;
+            if (tail == node) tail = upper;
+
+            if (!comp(val, node->values[node->count - 1])) node = upper;
+        }
+
+        int* pos = std::upper_bound(node->values, node->values + node->count, val, std::ref(comp));
+        std::copy_backward(pos, node->values + node->count, node->values + node->count + 1);
+        *pos = val;
+        ++node->count;
+    }
+
+    // stable merge of two sorted runs into freshly packed blocks, input blocks are recycled as they drain
+    template<typename Compare>
+    Run mergeRuns(Run left, Run right, Compare& comp) {
+        Run out{};
+        auto emit = [&](int val) {
+            if (!out.tail || out.tail->full()) {
+                UnrolledNode* node = newBlock();
+                if (out.tail) out.tail->next = node;
+                else out.head = node;
+                out.tail = node;
+            }
+            out.tail->values[out.tail->count++] = val;
+        };
+
+        UnrolledNode* l = left.head;
+        UnrolledNode* r = right.head;
+        std::uint32_t li = 0;
+        std::uint32_t ri = 0;
+
+        // recycle a drained block before the next one is requested
+        auto advance = [this](UnrolledNode*& node, std::uint32_t& idx) {
+            if (++idx < node->count) return;
+            UnrolledNode* next = node->next;
+            freeBlock(node);
+            node = next;
+            idx = 0;
+        };
+
+        while (l && r) {
+            if (comp(r->values[ri], l->values[li])) {
+                emit(r->values[ri]);
+                advance(r, ri);
+            }
+            else {
+                emit(l->values[li]);
+                advance(l, li);
+            }
+        }
+
+        // drain the partially consumed block, then splice the untouched rest of the run
+        UnrolledNode* rest = l ? l : r;
+        std::uint32_t restIdx = l ? li : ri;
+        const Run& restRun = l ? left : right;
+        if (rest && restIdx > 0) {
+            while (restIdx > 0) {
+                emit(rest->values[restIdx]);
+                advance(rest, restIdx);
+            }
+        }
+        if (rest) {
+            if (out.tail) out.tail->next = rest;
+            else out.head = rest;
+            out.tail = restRun.tail;
+        }
+
+        return out;
+    }
+};
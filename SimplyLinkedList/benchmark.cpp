@@ -0,0 +1,1628 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ConcurrentSortedList.h"
+#include "ExternalSort.h"
+#include "IndexedList.h"
+#include "LinkedList.h"
+#include "PersistentList.h"
+#include "SharedList.h"
+#include "SkipListIndex.h"
+#include "UnrolledLinkedList.h"
+
+using benchClock = std::chrono::steady_clock;
+
+static double elapsedNs(benchClock::time_point start, benchClock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// append throughput - with a tail pointer the cost per insert has to stay flat as the list grows
+static void benchAppend()
+{
+    std::cout << "append throughput" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "ns / insert" << std::setw(16) << "ns / size()" << std::endl;
+
+    for (const std::size_t n : { 1'000u, 10'000u, 100'000u, 1'000'000u, 10'000'000u }) {
+        LinkedList<int> list;
+
+        const auto insertStart = benchClock::now();
+        for (std::size_t i = 0; i < n; ++i) {
+            list.insert(static_cast<int>(i));
+        }
+        const auto insertEnd = benchClock::now();
+
+        // size() is read through a volatile sink so the calls are not folded away
+        volatile std::size_t sink = 0;
+        constexpr int sizeCalls = 1'000;
+        const auto sizeStart = benchClock::now();
+        for (int i = 0; i < sizeCalls; ++i) {
+            sink = sink + list.size();
+        }
+        const auto sizeEnd = benchClock::now();
+
+        std::cout << std::setw(12) << n
+            << std::setw(16) << std::fixed << std::setprecision(2) << elapsedNs(insertStart, insertEnd) / static_cast<double>(n)
+            << std::setw(16) << elapsedNs(sizeStart, sizeEnd) / sizeCalls << std::endl;
+    }
+}
+
+static std::vector<int> randomValues(std::size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(n));
+    std::vector<int> values(n);
+    for (auto& v : values) v = dist(rng);
+    return values;
+}
+
+// time a single call in milliseconds
+template<typename Fn>
+static double timeMs(Fn&& fn)
+{
+    const auto start = benchClock::now();
+    fn();
+    return elapsedNs(start, benchClock::now()) / 1e6;
+}
+
+// unrolled (block-node) list vs one value per node
+static void benchUnrolled()
+{
+    std::cout << "unrolled list vs LinkedList [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "operation" << std::setw(14) << "LinkedList" << std::setw(14) << "Unrolled" << std::endl;
+
+    for (const std::size_t n : { 100'000u, 1'000'000u }) {
+        const std::vector<int> values = randomValues(n, 42);
+        std::vector<int> toDelete(values.begin(), values.begin() + n / 100);
+
+        auto row = [n](std::string_view op, double linked, double unrolled) {
+            std::cout << std::setw(12) << n << std::setw(16) << op
+                << std::setw(14) << std::fixed << std::setprecision(2) << linked
+                << std::setw(14) << unrolled << std::endl;
+        };
+
+        LinkedList<int> linked;
+        UnrolledLinkedList unrolled;
+        row("insert",
+            timeMs([&] { for (int v : values) linked.insert(v); }),
+            timeMs([&] { for (int v : values) unrolled.insert(v); }));
+
+        // traversal after a sort, when list nodes are scattered over the pool
+        // a lambda keeps LinkedList on its merge sort, std::less<int> would radix sort
+        {
+            LinkedList<int> sortedLinked(linked);
+            UnrolledLinkedList sortedUnrolled(unrolled);
+            row("mergeSort",
+                timeMs([&] { sortedLinked.mergeSort([](int a, int b) { return a < b; }); }),
+                timeMs([&] { sortedUnrolled.mergeSort(); }));
+
+            volatile long long sink = 0;
+            row("traverse",
+                timeMs([&] { long long sum = 0; for (auto* node = sortedLinked.head; node; node = node->next) sum += node->val; sink = sum; }),
+                timeMs([&] { long long sum = 0; sortedUnrolled.forEach([&sum](int v) { sum += v; }); sink = sum; }));
+
+            LinkedList<int> otherLinked(sortedLinked);
+            UnrolledLinkedList otherUnrolled(sortedUnrolled);
+            row("merge",
+                timeMs([&] { sortedLinked.merge(otherLinked); }),
+                timeMs([&] { sortedUnrolled.merge(otherUnrolled); }));
+        }
+
+        row("reverse",
+            timeMs([&] { linked.reverseIterative(); }),
+            timeMs([&] { unrolled.reverse(); }));
+
+        row("deleteValues",
+            timeMs([&] { linked.deleteValues(toDelete); }),
+            timeMs([&] { unrolled.deleteValues(toDelete); }));
+    }
+}
+
+// inlined comparator vs std::function on the comparison-heavy paths
+static void benchComparator()
+{
+    using DynamicOrdering = LinkedList<int>::DynamicOrdering;
+
+    std::cout << "comparator - template vs std::function [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "operation" << std::setw(14) << "template" << std::setw(16) << "std::function" << std::endl;
+
+    auto row = [](std::size_t n, std::string_view op, double inlined, double erased) {
+        std::cout << std::setw(12) << n << std::setw(16) << op
+            << std::setw(14) << std::fixed << std::setprecision(2) << inlined
+            << std::setw(16) << erased << std::endl;
+    };
+
+    // a lambda on both sides, std::less<int> would take the template side to radix sort
+    auto lambdaLess = [](int a, int b) { return a < b; };
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        LinkedList<int> source;
+        for (int v : randomValues(n, 7)) source.insert(v);
+
+        LinkedList<int> inlined(source);
+        LinkedList<int> erased(source);
+        const DynamicOrdering dynamicLess = lambdaLess;
+        row(n, "mergeSort",
+            timeMs([&] { inlined.mergeSort(lambdaLess); }),
+            timeMs([&] { erased.mergeSort(dynamicLess); }));
+    }
+
+    // in-place merge of two sorted halves
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        LinkedList<int> evens;
+        LinkedList<int> odds;
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            evens.insert(static_cast<int>(2 * i));
+            odds.insert(static_cast<int>(2 * i + 1));
+        }
+
+        LinkedList<int> inlined(evens);
+        LinkedList<int> inlinedOther(odds);
+        const double inlinedMs = timeMs([&] { inlined.merge(inlinedOther, lambdaLess); });
+
+        LinkedList<int> erased(std::move(evens));
+        LinkedList<int> erasedOther(std::move(odds));
+        const DynamicOrdering dynamicLess = lambdaLess;
+        const double erasedMs = timeMs([&] { erased.merge(erasedOther, dynamicLess); });
+
+        row(n, "merge", inlinedMs, erasedMs);
+    }
+}
+
+// parallel merge sort scaling from 1 thread up to the number of cores
+// result has to match the sequential (stable) mergeSort node for node
+static void benchParallelSort()
+{
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "parallelMergeSort scaling - " << cores << " hardware threads [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(10) << "threads" << std::setw(14) << "time" << std::setw(12) << "speedup" << std::setw(12) << "identical" << std::endl;
+
+    // thread counts 1, 2, 4, ... up to the core count (at least 2 so the parallel path runs)
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t t = 1; t < std::max<std::size_t>(cores, 2); t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(std::max<std::size_t>(cores, 2));
+
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        // few distinct keys, stability is visible through the payload
+        struct Keyed {
+            int key;
+            int position;
+        };
+        auto byKey = [](const Keyed& a, const Keyed& b) { return a.key < b.key; };
+
+        LinkedList<Keyed> source;
+        std::mt19937 rng(11);
+        for (std::size_t i = 0; i < n; ++i) source.insert({ static_cast<int>(rng() % 1000), static_cast<int>(i) });
+
+        LinkedList<Keyed> reference(source);
+        const double sequentialMs = timeMs([&] { reference.mergeSort(byKey); });
+        std::cout << std::setw(12) << n << std::setw(10) << "seq" << std::setw(14) << std::fixed << std::setprecision(2) << sequentialMs << std::endl;
+
+        for (const std::size_t threads : threadCounts) {
+            LinkedList<Keyed> sorted(source);
+            const double ms = timeMs([&] { sorted.parallelMergeSort(byKey, threads); });
+
+            bool identical = sorted.size() == reference.size();
+            for (auto *a = sorted.head, *b = reference.head; identical && a; a = a->next, b = b->next) {
+                identical = a->val.key == b->val.key && a->val.position == b->val.position;
+            }
+
+            std::cout << std::setw(12) << n << std::setw(10) << threads << std::setw(14) << ms
+                << std::setw(12) << sequentialMs / ms << std::setw(12) << (identical ? "yes" : "NO") << std::endl;
+        }
+    }
+}
+
+// input shapes for the sort benchmarks
+static std::vector<int> shapedValues(std::string_view shape, std::size_t n, unsigned seed)
+{
+    std::vector<int> values(n);
+    std::mt19937 rng(seed);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (shape == "sorted") values[i] = static_cast<int>(i);
+        else if (shape == "reversed") values[i] = static_cast<int>(n - i);
+        else if (shape == "sawtooth") values[i] = static_cast<int>(i % 1000);
+        else values[i] = static_cast<int>(rng() >> 1);
+    }
+    // two merged sorted halves followed by a few stragglers
+    if (shape == "nearly") {
+        for (std::size_t i = 0; i < n; ++i) values[i] = static_cast<int>(i);
+        for (std::size_t i = 0; i < 16 && i < n; ++i) values[n - 1 - i] = static_cast<int>(rng() % n);
+    }
+    return values;
+}
+
+// adaptive natural merge sort vs mergeSort (and insertionSort on short lists) on differently shaped input
+static void benchAdaptiveSort()
+{
+    std::cout << "adaptiveSort vs mergeSort [ms / comparisons per node]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(10) << "shape" << std::setw(16) << "sort" << std::setw(12) << "time" << std::setw(14) << "comp / node" << std::endl;
+
+    for (const std::size_t n : { 20'000u, 1'000'000u }) {
+        for (const std::string_view shape : { "sorted", "reversed", "sawtooth", "nearly", "random" }) {
+            const std::vector<int> values = shapedValues(shape, n, 3);
+            LinkedList<int> source;
+            for (int v : values) source.insert(v);
+
+            std::size_t comparisons = 0;
+            auto countingLess = [&comparisons](int a, int b) { ++comparisons; return a < b; };
+
+            auto row = [&](std::string_view sort, auto&& run) {
+                LinkedList<int> list(source);
+                comparisons = 0;
+                const double ms = timeMs([&] { run(list); });
+                std::cout << std::setw(12) << n << std::setw(10) << shape << std::setw(16) << sort
+                    << std::setw(12) << std::fixed << std::setprecision(2) << ms
+                    << std::setw(14) << static_cast<double>(comparisons) / static_cast<double>(n) << std::endl;
+            };
+
+            row("adaptiveSort", [&](LinkedList<int>& list) { list.adaptiveSort(countingLess); });
+            row("mergeSort", [&](LinkedList<int>& list) { list.mergeSort(countingLess); });
+            if (n <= 20'000) {
+                row("insertionSort", [&](LinkedList<int>& list) { list.insertionSort(countingLess); });
+            }
+        }
+    }
+}
+
+// radix sort dispatch vs the comparison based merge sort on random ints (negative values included)
+static void benchRadixSort()
+{
+    std::cout << "mergeSort radix dispatch vs comparison merge sort [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(10) << "order" << std::setw(14) << "radix" << std::setw(14) << "comparison" << std::setw(10) << "ratio" << std::endl;
+
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        LinkedList<int> source;
+        std::mt19937 rng(17);
+        for (std::size_t i = 0; i < n; ++i) source.insert(static_cast<int>(rng()));
+
+        auto row = [&](std::string_view order, auto standardOrdering) {
+            // a lambda is not a known standard ordering, mergeSort stays comparison based
+            auto lambdaOrdering = [standardOrdering](int a, int b) { return standardOrdering(a, b); };
+
+            LinkedList<int> radix(source);
+            LinkedList<int> comparison(source);
+            const double radixMs = timeMs([&] { radix.mergeSort(standardOrdering); });
+            const double comparisonMs = timeMs([&] { comparison.mergeSort(lambdaOrdering); });
+
+            std::cout << std::setw(12) << n << std::setw(10) << order
+                << std::setw(14) << std::fixed << std::setprecision(2) << radixMs
+                << std::setw(14) << comparisonMs << std::setw(10) << comparisonMs / radixMs << std::endl;
+        };
+        row("less", std::less<int>());
+        row("greater", std::greater<int>());
+    }
+}
+
+// deleteValues as it was before the adaptive membership backends - one std::set lookup per node
+static void deleteValuesStdSet(LinkedList<int>& list, const std::vector<int>& values)
+{
+    const std::set<int> deleteSet(values.begin(), values.end());
+    LinkedList<int>::ListNode** link = &list.head;
+    LinkedList<int>::ListNode* current = nullptr;
+    while (*link) {
+        if (deleteSet.contains((*link)->val)) {
+            LinkedList<int>::ListNode* temp = *link;
+            *link = temp->next;
+            list.freeNode(temp);
+            --list.count;
+        }
+        else {
+            current = *link;
+            link = &current->next;
+        }
+    }
+    list.tail = current;
+}
+
+// deleteValues with growing delete sets against the std::set baseline
+// compact values come from [0, nodes), sparse values from the full positive int range
+// half of the delete values are taken from the list, the other half are random
+static void benchDeleteValues()
+{
+    constexpr std::size_t n = 10'000'000;
+    std::cout << "deleteValues on " << n << " nodes vs std::set lookups [ms]" << std::endl;
+    std::cout << std::setw(10) << "deletes" << std::setw(10) << "values" << std::setw(10) << "list" << std::setw(10) << "backend"
+        << std::setw(12) << "std::set" << std::setw(12) << "adaptive" << std::setw(10) << "ratio" << std::setw(12) << "identical" << std::endl;
+
+    for (const std::string_view distribution : { "compact", "sparse" }) {
+        std::mt19937 rng(29);
+        auto draw = [&] { return distribution == "compact" ? static_cast<int>(rng() % n) : static_cast<int>(rng() >> 1); };
+        std::vector<int> values(n);
+        for (auto& v : values) v = draw();
+
+        for (const std::string_view order : { "random", "sorted" }) {
+            if (order == "sorted") std::sort(values.begin(), values.end());
+            LinkedList<int> source;
+            for (int v : values) source.insert(v);
+
+            for (const std::size_t deletes : { 1'000u, 100'000u, 1'000'000u }) {
+                std::vector<int> toDelete(deletes);
+                for (std::size_t i = 0; i < deletes; ++i) toDelete[i] = i % 2 ? draw() : values[rng() % n];
+
+                std::vector<int> sortedDeletes(toDelete);
+                std::sort(sortedDeletes.begin(), sortedDeletes.end());
+                sortedDeletes.erase(std::unique(sortedDeletes.begin(), sortedDeletes.end()), sortedDeletes.end());
+                // a sorted list never leaves the merge path
+                const char* backend = order == "sorted" ? "merge" : membershipKindName(chooseMembership(std::span<const int>(sortedDeletes)));
+
+                LinkedList<int> baseline(source);
+                LinkedList<int> adaptive(source);
+                const double baselineMs = timeMs([&] { deleteValuesStdSet(baseline, toDelete); });
+                const double adaptiveMs = timeMs([&] { adaptive.deleteValues(toDelete); });
+
+                bool identical = baseline.size() == adaptive.size();
+                for (auto *a = baseline.head, *b = adaptive.head; identical && a; a = a->next, b = b->next) {
+                    identical = a->val == b->val;
+                }
+
+                std::cout << std::setw(10) << deletes << std::setw(10) << distribution << std::setw(10) << order << std::setw(10) << backend
+                    << std::setw(12) << std::fixed << std::setprecision(2) << baselineMs << std::setw(12) << adaptiveMs
+                    << std::setw(10) << baselineMs / adaptiveMs << std::setw(12) << (identical ? "yes" : "NO") << std::endl;
+            }
+        }
+    }
+}
+
+// k-way merge of sorted shards vs folding them in with pairwise merges
+// packed shards are built from sorted values (nodes in address order), scattered shards are sorted in place by mergeSort
+// every variant has to produce the same (stable) list
+static void benchKWayMerge()
+{
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "mergeKWay vs pairwise merge of k sorted shards [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(8) << "k" << std::setw(12) << "layout" << std::setw(14) << "pairwise" << std::setw(14) << "kway"
+        << std::setw(14) << "parallel" << std::setw(12) << "identical" << std::endl;
+
+    struct Keyed {
+        int key;
+        int position;
+    };
+    auto byKey = [](const Keyed& a, const Keyed& b) { return a.key < b.key; };
+
+    constexpr std::size_t n = 1'000'000;
+    for (const std::size_t k : { 4u, 16u, 256u }) {
+        for (const std::string_view layout : { "packed", "scattered" }) {
+            // first shard is the target, the rest is merged into it
+            auto run = [&](auto&& merge) {
+                std::vector<LinkedList<Keyed>> shards(k);
+                std::mt19937 rng(23);
+                for (std::size_t s = 0; s < k; ++s) {
+                    std::vector<int> keys(n / k);
+                    for (auto& key : keys) key = static_cast<int>(rng() % n);
+                    if (layout == "packed") std::sort(keys.begin(), keys.end());
+                    for (std::size_t i = 0; i < keys.size(); ++i) shards[s].insert({ keys[i], static_cast<int>(s * n + i) });
+                    if (layout == "scattered") shards[s].mergeSort(byKey);
+                }
+                double ms = timeMs([&] { merge(shards.front(), std::span(shards).subspan(1)); });
+                return std::pair{ ms, std::move(shards.front()) };
+            };
+
+            auto [pairwiseMs, pairwise] = run([&](LinkedList<Keyed>& target, std::span<LinkedList<Keyed>> others) {
+                for (auto& other : others) target.merge(other, byKey);
+            });
+            auto [kWayMs, kWay] = run([&](LinkedList<Keyed>& target, std::span<LinkedList<Keyed>> others) {
+                target.mergeKWay(others, byKey);
+            });
+            auto [parallelMs, parallel] = run([&](LinkedList<Keyed>& target, std::span<LinkedList<Keyed>> others) {
+                target.parallelMergeKWay(others, byKey, std::max<std::size_t>(cores, 2));
+            });
+
+            bool identical = kWay.size() == pairwise.size() && parallel.size() == pairwise.size();
+            for (auto *a = pairwise.head, *b = kWay.head, *c = parallel.head; identical && a; a = a->next, b = b->next, c = c->next) {
+                identical = a->val.position == b->val.position && a->val.position == c->val.position;
+            }
+
+            std::cout << std::setw(12) << n << std::setw(8) << k << std::setw(12) << layout << std::setw(14) << std::fixed << std::setprecision(2) << pairwiseMs
+                << std::setw(14) << kWayMs << std::setw(14) << parallelMs << std::setw(12) << (identical ? "yes" : "NO") << std::endl;
+        }
+    }
+}
+
+// LinkedList kept sorted under a single mutex - baseline for the lock-free list
+class MutexSortedList {
+public:
+    bool insert(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        LinkedList<int>::ListNode** link = &list.head;
+        while (*link && (*link)->val < value) link = &(*link)->next;
+        if (*link && (*link)->val == value) return false;
+
+        LinkedList<int>::ListNode* node = list.newNode(value);
+        node->next = *link;
+        if (!node->next) list.tail = node;
+        *link = node;
+        ++list.count;
+        return true;
+    }
+
+    bool deleteValue(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t before = list.size();
+        list.deleteValue(value);
+        return list.size() != before;
+    }
+
+    bool contains(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const LinkedList<int>::ListNode* node = list.head;
+        while (node && node->val < value) node = node->next;
+        return node && node->val == value;
+    }
+
+private:
+    std::mutex mutex;
+    LinkedList<int> list;
+};
+
+// lock-free sorted list: stress check and throughput against the mutex baseline
+// stress - every thread counts its successful inserts minus deletes per key, the sums have to match the final contents
+// exits with a failure code if they do not
+static void benchConcurrentList()
+{
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "ConcurrentSortedList - " << cores << " hardware threads" << std::endl;
+
+    {
+        constexpr int threads = 8;
+        constexpr int keys = 256;
+        constexpr int operations = 200'000;
+
+        ConcurrentSortedList<int> list;
+        std::vector<std::vector<long>> net(threads, std::vector<long>(keys));
+        std::atomic<bool> unsortedSnapshot{ false };
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 rng(t);
+                for (int i = 0; i < operations; ++i) {
+                    const int key = static_cast<int>(rng() % keys);
+                    switch (rng() % 4) {
+                    case 0: if (list.insert(key)) ++net[t][key]; break;
+                    case 1: if (list.deleteValue(key)) --net[t][key]; break;
+                    case 2: list.contains(key); break;
+                    default:
+                        if (i % 64 == 0) {
+                            const std::vector<int> values = list.snapshot();
+                            if (!std::is_sorted(values.begin(), values.end()) || std::adjacent_find(values.begin(), values.end()) != values.end()) {
+                                unsortedSnapshot = true;
+                            }
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        const std::vector<int> values = list.snapshot();
+        bool consistent = !unsortedSnapshot && values.size() == list.size();
+        for (int key = 0; key < keys; ++key) {
+            long present = 0;
+            for (int t = 0; t < threads; ++t) present += net[t][key];
+            consistent = consistent && present == (std::binary_search(values.begin(), values.end(), key) ? 1 : 0);
+        }
+        std::cout << "stress - " << threads << " threads x " << operations << " operations on " << keys << " keys: "
+            << (consistent ? "OK" : "FAILED") << std::endl;
+        if (!consistent) std::exit(EXIT_FAILURE);
+    }
+
+    // 50% contains, 25% insert, 25% delete on a prefilled key range
+    std::cout << "throughput [Mops / s]" << std::endl;
+    std::cout << std::setw(10) << "keys" << std::setw(10) << "threads" << std::setw(14) << "mutex" << std::setw(14) << "lock-free" << std::endl;
+
+    constexpr int operations = 200'000;
+    auto throughput = [&](auto& list, int keys, std::size_t threads) {
+        std::mt19937 fill(7);
+        for (int i = 0; i < keys / 2; ++i) list.insert(static_cast<int>(fill() % keys));
+
+        const double ms = timeMs([&] {
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(static_cast<unsigned>(t) + 100);
+                    for (int i = 0; i < operations; ++i) {
+                        const int key = static_cast<int>(rng() % keys);
+                        const unsigned op = rng() % 4;
+                        if (op == 0) list.insert(key);
+                        else if (op == 1) list.deleteValue(key);
+                        else list.contains(key);
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+        });
+        return static_cast<double>(operations * threads) / ms / 1e3;
+    };
+
+    for (const int keys : { 64, 1024 }) {
+        for (std::size_t threads = 1; threads <= std::max<std::size_t>(cores * 2, 4); threads *= 2) {
+            MutexSortedList locked;
+            ConcurrentSortedList<int> lockFree;
+            const double lockedRate = throughput(locked, keys, threads);
+            const double lockFreeRate = throughput(lockFree, keys, threads);
+            std::cout << std::setw(10) << keys << std::setw(10) << threads
+                << std::setw(14) << std::fixed << std::setprecision(2) << lockedRate << std::setw(14) << lockFreeRate << std::endl;
+        }
+    }
+}
+
+// list file with the nodes stored in random slots - what compactListFile is for
+static void writeScatteredListFile(const std::filesystem::path& path, const std::vector<int>& values, unsigned seed)
+{
+    using Node = ListFileNode<int>;
+    const std::uint64_t firstNode = listFileFirstNode<int>();
+
+    std::vector<std::uint64_t> slots(values.size());
+    for (std::size_t i = 0; i < slots.size(); ++i) slots[i] = firstNode + i * sizeof(Node);
+    std::shuffle(slots.begin(), slots.end(), std::mt19937(seed));
+
+    ListFileHeader header{};
+    std::memcpy(header.magic, ListFileHeader::expectedMagic, sizeof(header.magic));
+    header.version = ListFileHeader::currentVersion;
+    header.byteOrder = ListFileHeader::byteOrderMark;
+    header.nodeSize = sizeof(Node);
+    header.nodeAlign = alignof(Node);
+    header.valueSize = sizeof(int);
+    header.valueAlign = alignof(int);
+    header.count = values.size();
+    header.head = values.empty() ? 0 : slots.front();
+    header.tail = values.empty() ? 0 : slots.back();
+
+    std::vector<std::byte> image(firstNode + values.size() * sizeof(Node));
+    std::memcpy(image.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const Node node{ values[i], i + 1 < values.size() ? slots[i + 1] : 0 };
+        std::memcpy(image.data() + slots[i], &node, sizeof(node));
+    }
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+}
+
+// rebuilding a list from text vs the mapped list file format
+// exits with a failure code if a mapped traversal does not see the saved values
+static void benchPersistentList()
+{
+    constexpr std::size_t n = 10'000'000;
+    std::cout << "list file of " << n << " nodes [ms]" << std::endl;
+
+    const std::vector<int> values = randomValues(n, 31);
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::filesystem::path textPath = dir / "SimplyLinkedListBenchmark.txt";
+    const std::filesystem::path listPath = dir / "SimplyLinkedListBenchmark.sll";
+    const std::filesystem::path scatteredPath = dir / "SimplyLinkedListBenchmark.scattered.sll";
+
+    long long expectedSum = 0;
+    {
+        std::ofstream text(textPath);
+        for (int v : values) {
+            text << v << '\n';
+            expectedSum += v;
+        }
+    }
+
+    auto row = [](std::string_view what, double ms) {
+        std::cout << std::setw(36) << what << std::setw(12) << std::fixed << std::setprecision(2) << ms << std::endl;
+    };
+    auto sumOf = [](const MappedList<int>& mapped) {
+        long long sum = 0;
+        for (int v : mapped) sum += v;
+        return sum;
+    };
+    auto check = [&](bool ok, std::string_view what) {
+        if (ok) return;
+        std::cout << "FAILED - " << what << std::endl;
+        std::exit(EXIT_FAILURE);
+    };
+
+    row("text parse + insert", timeMs([&] {
+        LinkedList<int> list;
+        std::ifstream text(textPath);
+        for (int v; text >> v;) list.insert(v);
+        check(list.size() == n, "text rebuild");
+    }));
+
+    LinkedList<int> list;
+    for (int v : values) list.insert(v);
+    row("saveList", timeMs([&] { saveList(list, listPath); }));
+
+    row("loadList", timeMs([&] {
+        const LinkedList<int> loaded = loadList<int>(listPath);
+        check(loaded.size() == n, "loadList");
+    }));
+
+    long long sum = 0;
+    row("map + traverse", timeMs([&] {
+        const MappedList<int> mapped(listPath);
+        sum = sumOf(mapped);
+    }));
+    check(sum == expectedSum, "mapped traversal");
+
+    writeScatteredListFile(scatteredPath, values, 5);
+    row("map + traverse scattered file", timeMs([&] {
+        const MappedList<int> mapped(scatteredPath);
+        sum = sumOf(mapped);
+    }));
+    check(sum == expectedSum, "scattered traversal");
+
+    row("compactListFile", timeMs([&] { compactListFile<int>(scatteredPath); }));
+    row("map + traverse compacted file", timeMs([&] {
+        const MappedList<int> mapped(scatteredPath);
+        sum = sumOf(mapped);
+        check(mapped.isSequential(), "compacted file is not sequential");
+    }));
+    check(sum == expectedSum, "compacted traversal");
+
+    for (const auto& path : { textPath, listPath, scatteredPath }) std::filesystem::remove(path);
+}
+
+// skip-list index vs linear walks on a sorted list: lookups, sorted inserts and range erases
+// exits with a failure code if the indexed list differs from the linearly maintained one
+static void benchSkipListIndex()
+{
+    std::cout << "skip-list index vs linear walk on a sorted list [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "operation" << std::setw(10) << "count" << std::setw(12) << "linear"
+        << std::setw(12) << "index" << std::setw(10) << "ratio" << std::endl;
+
+    for (const std::size_t n : { 100'000u, 1'000'000u }) {
+        std::vector<int> values = randomValues(n, 31);
+        std::sort(values.begin(), values.end());
+        LinkedList<int> linear;
+        for (int v : values) linear.insert(v);
+        LinkedList<int> indexed(linear);
+
+        // linear baseline - walk to the last node ordered before value
+        auto linkBefore = [&linear](int value) {
+            ListNode<int>** link = &linear.head;
+            while (*link && (*link)->val < value) link = &(*link)->next;
+            return link;
+        };
+
+        constexpr std::size_t ops = 1'000;
+        std::vector<int> probes(ops);
+        std::mt19937 rng(37);
+        for (auto& v : probes) v = static_cast<int>(rng() % (n + 1));
+
+        auto row = [n](std::string_view op, std::size_t count, double linearMs, double indexMs) {
+            std::cout << std::setw(12) << n << std::setw(16) << op << std::setw(10) << count
+                << std::setw(12) << std::fixed << std::setprecision(2) << linearMs << std::setw(12) << indexMs
+                << std::setw(10) << linearMs / indexMs << std::endl;
+        };
+
+        SkipListIndex<int> index(indexed);
+        const double buildMs = timeMs([&] { index.rebuild(); });
+        std::cout << std::setw(12) << n << std::setw(16) << "build" << std::setw(10) << n << std::setw(12) << "-"
+            << std::setw(12) << std::fixed << std::setprecision(2) << buildMs << std::endl;
+
+        volatile long long sink = 0;
+        row("lowerBound", ops,
+            timeMs([&] { for (int v : probes) { ListNode<int>* node = *linkBefore(v); sink = sink + (node ? node->val : 0); } }),
+            timeMs([&] { for (int v : probes) { ListNode<int>* node = index.lowerBound(v); sink = sink + (node ? node->val : 0); } }));
+
+        row("insert", ops,
+            timeMs([&] {
+                for (int v : probes) {
+                    ListNode<int>** link = linkBefore(v + 1);
+                    ListNode<int>* node = linear.newNode(v, *link);
+                    *link = node;
+                    if (!node->next) linear.tail = node;
+                    ++linear.count;
+                }
+            }),
+            timeMs([&] { for (int v : probes) index.insert(v); }));
+
+        std::size_t linearErased = 0;
+        std::size_t indexErased = 0;
+        row("erase range", ops / 10,
+            timeMs([&] {
+                for (std::size_t i = 0; i < ops / 10; ++i) {
+                    ListNode<int>* prev = nullptr;
+                    ListNode<int>* node = linear.head;
+                    while (node && node->val < probes[i]) {
+                        prev = node;
+                        node = node->next;
+                    }
+                    while (node && node->val < probes[i] + 50) {
+                        ListNode<int>* next = node->next;
+                        linear.freeNode(node);
+                        node = next;
+                        --linear.count;
+                        ++linearErased;
+                    }
+                    (prev ? prev->next : linear.head) = node;
+                    if (!node) linear.tail = prev;
+                }
+            }),
+            timeMs([&] { for (std::size_t i = 0; i < ops / 10; ++i) indexErased += index.erase(probes[i], probes[i] + 50); }));
+
+        bool identical = linearErased == indexErased && linear.size() == indexed.size() && indexed.checkInvariants();
+        for (auto *a = linear.head, *b = indexed.head; identical && a; a = a->next, b = b->next) {
+            identical = a->val == b->val;
+        }
+        if (!identical) {
+            std::cout << "FAILED - indexed list differs from the linear one" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// structure-of-arrays list with 32-bit links vs one heap node per value
+// exits with a failure code if both lists end up with different values
+static void benchIndexedList()
+{
+    std::cout << "IndexedList (32-bit links) vs LinkedList [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "operation" << std::setw(14) << "LinkedList" << std::setw(14) << "IndexedList" << std::endl;
+
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        const std::vector<int> values = randomValues(n, 53);
+        std::vector<int> toDelete(values.begin(), values.begin() + n / 100);
+        auto lambdaLess = [](int a, int b) { return a < b; };
+
+        auto row = [n](std::string_view op, double linked, double indexed) {
+            std::cout << std::setw(12) << n << std::setw(16) << op
+                << std::setw(14) << std::fixed << std::setprecision(2) << linked
+                << std::setw(14) << indexed << std::endl;
+        };
+
+        auto linked = std::make_unique<LinkedList<int>>();
+        auto indexed = std::make_unique<IndexedList<int>>();
+        row("insert",
+            timeMs([&] { for (int v : values) linked->insert(v); }),
+            timeMs([&] { for (int v : values) indexed->insert(v); }));
+
+        // a lambda keeps LinkedList::mergeSort comparison based like the indexed one
+        row("mergeSort",
+            timeMs([&] { linked->mergeSort(lambdaLess); }),
+            timeMs([&] { indexed->mergeSort(lambdaLess); }));
+
+        volatile long long sink = 0;
+        row("traverse",
+            timeMs([&] { long long sum = 0; linked->forEach([&sum](int v) { sum += v; }); sink = sum; }),
+            timeMs([&] { long long sum = 0; indexed->forEach([&sum](int v) { sum += v; }); sink = sum; }));
+
+        row("reverse",
+            timeMs([&] { linked->reverseIterative(); }),
+            timeMs([&] { indexed->reverseIterative(); }));
+
+        row("deleteValues",
+            timeMs([&] { linked->deleteValues(toDelete); }),
+            timeMs([&] { indexed->deleteValues(toDelete); }));
+
+        // bytes per value - list nodes vs both arrays
+        row("bytes / value",
+            static_cast<double>(sizeof(ListNode<int>)),
+            static_cast<double>(indexed->values.capacity() * sizeof(int) + indexed->links.capacity() * sizeof(IndexedList<int>::Index)) / static_cast<double>(n));
+
+        bool identical = linked->size() == indexed->size();
+        std::vector<int> linkedValues;
+        linked->forEach([&linkedValues](int v) { linkedValues.push_back(v); });
+        std::size_t i = 0;
+        indexed->forEach([&](int v) { identical = identical && i < linkedValues.size() && linkedValues[i++] == v; });
+        if (!identical) {
+            std::cout << "FAILED - LinkedList and IndexedList differ" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        row("destroy",
+            timeMs([&] { linked.reset(); }),
+            timeMs([&] { indexed.reset(); }));
+    }
+}
+
+// copy-on-write SharedList vs deep LinkedList copies: read-mostly fan-out, then one write per copy
+// exits with a failure code if a copy or the source ends up with wrong values
+static void benchSharedList()
+{
+    constexpr std::size_t copies = 16;
+    std::cout << "SharedList (copy-on-write) vs LinkedList - " << copies << " copies [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(18) << "operation" << std::setw(14) << "LinkedList" << std::setw(14) << "SharedList" << std::endl;
+
+    for (const std::size_t n : { 100'000u, 1'000'000u }) {
+        LinkedList<int> source;
+        for (int v : randomValues(n, 59)) source.insert(v);
+        const SharedList<int> shared(source);
+
+        auto row = [n](std::string_view op, double linked, double cow) {
+            std::cout << std::setw(12) << n << std::setw(18) << op
+                << std::setw(14) << std::fixed << std::setprecision(2) << linked << std::setw(14) << cow << std::endl;
+        };
+
+        std::vector<LinkedList<int>> linkedCopies;
+        std::vector<SharedList<int>> sharedCopies;
+        linkedCopies.reserve(copies);
+        sharedCopies.reserve(copies);
+        row("copy",
+            timeMs([&] { for (std::size_t i = 0; i < copies; ++i) linkedCopies.push_back(source); }),
+            timeMs([&] { for (std::size_t i = 0; i < copies; ++i) sharedCopies.push_back(shared); }));
+
+        volatile long long sink = 0;
+        row("read",
+            timeMs([&] { for (const auto& copy : linkedCopies) { long long sum = 0; copy.forEach([&sum](int v) { sum += v; }); sink = sum; } }),
+            timeMs([&] { for (const auto& copy : sharedCopies) { long long sum = 0; copy.forEach([&sum](int v) { sum += v; }); sink = sum; } }));
+
+        // the middle deletion copies half of the chain, the rest stays shared
+        row("deleteMiddleNode",
+            timeMs([&] { for (auto& copy : linkedCopies) copy.deleteMiddleNode(); }),
+            timeMs([&] { for (auto& copy : sharedCopies) copy.deleteMiddleNode(); }));
+
+        // appending needs the whole chain of its own
+        row("insert",
+            timeMs([&] { for (auto& copy : linkedCopies) copy.insert(-1); }),
+            timeMs([&] { for (auto& copy : sharedCopies) copy.insert(-1); }));
+
+        bool identical = shared.size() == n;
+        for (std::size_t i = 0; identical && i < copies; ++i) {
+            std::vector<int> expected;
+            std::vector<int> actual;
+            linkedCopies[i].forEach([&expected](int v) { expected.push_back(v); });
+            sharedCopies[i].forEach([&actual](int v) { actual.push_back(v); });
+            identical = expected == actual;
+        }
+        // the shared source is never written through a copy
+        std::vector<int> sourceValues;
+        std::vector<int> sharedValues;
+        source.forEach([&sourceValues](int v) { sourceValues.push_back(v); });
+        shared.forEach([&sharedValues](int v) { sharedValues.push_back(v); });
+        identical = identical && sourceValues == sharedValues && shared.sharedNodes() == 0;
+        if (!identical) {
+            std::cout << "FAILED - copies or source differ" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// range constructor and iterator based walks vs the insert loop and forEach
+// a views pipeline on the list against the same pipeline on a vector copy of it
+static void benchRanges()
+{
+    std::cout << "iterators and ranges [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(28) << "operation" << std::setw(12) << "time" << std::endl;
+
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        const std::vector<int> values = randomValues(n, 61);
+        auto row = [n](std::string_view op, double ms) {
+            std::cout << std::setw(12) << n << std::setw(28) << op << std::setw(12) << std::fixed << std::setprecision(2) << ms << std::endl;
+        };
+
+        LinkedList<int> inserted;
+        row("insert loop", timeMs([&] { for (int v : values) inserted.insert(v); }));
+        std::optional<LinkedList<int>> ranged;
+        row("from_range constructor", timeMs([&] { ranged.emplace(from_range, values); }));
+
+        volatile long long sink = 0;
+        row("forEach", timeMs([&] { long long sum = 0; ranged->forEach([&sum](int v) { sum += v; }); sink = sum; }));
+        row("range-for", timeMs([&] { long long sum = 0; for (int v : *ranged) sum += v; sink = sum; }));
+
+        auto pipeline = [](const auto& range) {
+            long long sum = 0;
+            for (int v : range | std::views::filter([](int x) { return x % 3 == 0; })
+                               | std::views::transform([](int x) { return x / 2; })
+                               | std::views::take(range.size() / 10)) {
+                sum += v;
+            }
+            return sum;
+        };
+        long long listSum = 0;
+        long long vectorSum = 0;
+        row("pipeline on the list", timeMs([&] { listSum = pipeline(*ranged); }));
+        row("vector copy + pipeline", timeMs([&] { vectorSum = pipeline(std::vector<int>(ranged->begin(), ranged->end())); }));
+
+        if (listSum != vectorSum || !std::ranges::equal(inserted, *ranged)) {
+            std::cout << "FAILED - range results differ" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// in-place set operations on sorted lists against the std algorithms on sorted vectors
+// comparisons are counted on an instrumented list - a linear walk makes about one per node of both inputs
+static void benchSetOperations()
+{
+    using CountedList = LinkedList<int, PoolAllocator<int>, CountingInstrumentation>;
+    std::cout << "set operations on sorted inputs [ms]" << std::endl;
+    std::cout << std::setw(10) << "left" << std::setw(10) << "right" << std::setw(16) << "operation" << std::setw(12) << "list"
+        << std::setw(12) << "vector" << std::setw(14) << "comparisons" << std::endl;
+
+    // both inputs spread over the same range, so the walk covers the longer one completely
+    auto sortedValues = [](std::size_t n, unsigned seed, int range) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(0, range);
+        std::vector<int> values(n);
+        for (int& v : values) v = dist(rng);
+        std::sort(values.begin(), values.end());
+        return values;
+    };
+
+    struct Case {
+        std::size_t left;
+        std::size_t right;
+    };
+    for (const Case c : { Case{ 1'000'000, 1'000'000 }, Case{ 10'000, 1'000'000 }, Case{ 1'000, 1'000'000 } }) {
+        const int range = static_cast<int>(2 * std::max(c.left, c.right));
+        const std::vector<int> left = sortedValues(c.left, 73, range);
+        const std::vector<int> right = sortedValues(c.right, 79, range);
+
+        auto measure = [&](std::string_view name, std::string_view operation, auto listOp, auto vectorOp) {
+            LinkedList<int> a(from_range, left);
+            LinkedList<int> b(from_range, right);
+            const double listMs = timeMs([&] { listOp(a, b); });
+
+            std::vector<int> out;
+            out.reserve(left.size() + right.size());
+            const double vectorMs = timeMs([&] { vectorOp(std::back_inserter(out)); });
+
+            CountedList counted(from_range, left);
+            CountedList countedOther(from_range, right);
+            listOp(counted, countedOther);
+            const std::uint64_t comparisons = counted.instrumentation.totals().at(operation).comparisons;
+
+            std::cout << std::setw(10) << c.left << std::setw(10) << c.right << std::setw(16) << name << std::setw(12) << std::fixed
+                << std::setprecision(2) << listMs << std::setw(12) << vectorMs << std::setw(14) << comparisons << std::endl;
+            if (!std::ranges::equal(a, out) || !std::ranges::equal(counted, out)) {
+                std::cout << "FAILED - " << name << " differs from the std algorithm" << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        };
+
+        measure("intersection", "setIntersection", [](auto& a, auto& b) { a.setIntersection(b); },
+            [&](auto out) { std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), out); });
+        measure("union", "setUnion", [](auto& a, auto& b) { a.setUnion(b); },
+            [&](auto out) { std::set_union(left.begin(), left.end(), right.begin(), right.end(), out); });
+        measure("difference", "setDifference", [](auto& a, auto& b) { a.setDifference(b); },
+            [&](auto out) { std::set_difference(left.begin(), left.end(), right.begin(), right.end(), out); });
+    }
+}
+
+// external sort of four times its memory budget, into a list and into a list file, against an in-memory mergeSort
+static void benchExternalSort()
+{
+    ExternalSortOptions options;
+    options.memoryBudget = std::size_t{ 16 } << 20;
+    const std::size_t n = 4 * options.memoryBudget / sizeof(int);
+    std::cout << "external sort of " << n << " ints, " << (options.memoryBudget >> 20) << " MiB budget [ms]" << std::endl;
+
+    const std::vector<int> values = randomValues(n, 71);
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    auto row = [](std::string_view what, double ms, const ExternalSortStats* stats) {
+        std::cout << std::setw(24) << what << std::setw(12) << std::fixed << std::setprecision(2) << ms;
+        if (stats) std::cout << "   runs " << stats->runs << ", passes " << stats->mergePasses << ", " << (stats->bytesWritten >> 20) << " MiB written";
+        std::cout << std::endl;
+    };
+    auto fail = [](std::string_view what) {
+        std::cout << "FAILED - " << what << std::endl;
+        std::exit(EXIT_FAILURE);
+    };
+
+    {
+        ExternalSorter<int> sorter(options);
+        LinkedList<int> sorted;
+        const double ms = timeMs([&] {
+            sorter.addRange(values);
+            sorter.sortInto(sorted);
+        });
+        row("external into a list", ms, &sorter.statistics());
+        if (!std::ranges::equal(sorted, expected)) fail("external sort into a list");
+    }
+
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "SimplyLinkedListBenchmark.sorted.sll";
+        ExternalSorter<int> sorter(options);
+        const double ms = timeMs([&] {
+            sorter.addRange(values);
+            sorter.sortToListFile(path);
+        });
+        row("external into a file", ms, &sorter.statistics());
+        {
+            const MappedList<int> mapped(path);
+            if (!std::ranges::equal(mapped, expected)) fail("external sort into a list file");
+        }
+        std::filesystem::remove(path);
+    }
+
+    {
+        LinkedList<int> list;
+        const double ms = timeMs([&] {
+            for (int v : values) list.insert(v);
+            list.mergeSort();
+        });
+        row("in-memory mergeSort", ms, nullptr);
+    }
+}
+
+// cost of the counting instrumentation policy, the default policy has to cost nothing
+static void benchInstrumentation()
+{
+    using CountedList = LinkedList<int, PoolAllocator<int>, CountingInstrumentation>;
+    std::cout << "instrumentation [ms]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(16) << "operation" << std::setw(12) << "none" << std::setw(12) << "counting" << std::endl;
+
+    auto byValue = [](int a, int b) { return a < b; };
+    for (const std::size_t n : { 1'000'000u, 4'000'000u }) {
+        const std::vector<int> values = randomValues(n, 67);
+        auto row = [n](std::string_view op, double none, double counting) {
+            std::cout << std::setw(12) << n << std::setw(16) << op << std::setw(12) << std::fixed << std::setprecision(2) << none
+                << std::setw(12) << counting << std::endl;
+        };
+
+        LinkedList<int> plain(from_range, values);
+        CountedList counted(from_range, values);
+        const double plainSort = timeMs([&] { plain.mergeSort(byValue); });
+        const double countedSort = timeMs([&] { counted.mergeSort(byValue); });
+        row("mergeSort", plainSort, countedSort);
+
+        LinkedList<int> plainOther(from_range, values);
+        CountedList countedOther(from_range, values);
+        plainOther.mergeSort(byValue);
+        countedOther.mergeSort(byValue);
+        const double plainMerge = timeMs([&] { plain.merge(plainOther, byValue); });
+        const double countedMerge = timeMs([&] { counted.merge(countedOther, byValue); });
+        row("merge", plainMerge, countedMerge);
+
+        const OperationCounters& sort = counted.instrumentation.totals().at("mergeSort");
+        if (!std::ranges::equal(plain, counted) || sort.comparisons == 0 || sort.visited < n) {
+            std::cout << "FAILED - instrumented list differs" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// hardware cache-miss counter of the calling thread (Linux perf_event_open)
+// unavailable on other platforms, without a PMU (most virtual machines) or when perf_event_paranoid forbids it
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    // misses while fn runs, -1 if the counter is unavailable
+    template<typename Fn>
+    long long count(Fn&& fn) {
+        if (!available()) {
+            fn();
+            return -1;
+        }
+        long long misses = -1;
+#ifdef __linux__
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        fn();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses)) misses = -1;
+#endif
+        return misses;
+    }
+
+private:
+    int fd = -1;
+};
+
+// traversal of a list fragmented by sort, deleteValues and merge, before and after relinearize
+// plain and prefetching walks, exits with a failure code if relinearize changed the values
+static void benchRelinearize()
+{
+    CacheMissCounter missCounter;
+    std::cout << "traversal before / after relinearize [ms, cache misses " << (missCounter.available() ? "from perf_event_open" : "unavailable") << "]" << std::endl;
+    std::cout << std::setw(12) << "nodes" << std::setw(14) << "layout" << std::setw(12) << "traversal" << std::setw(10) << "time"
+        << std::setw(12) << "ns / node" << std::setw(14) << "misses / node" << std::setw(14) << "sequential %" << std::endl;
+
+    for (const std::size_t n : { 1'000'000u, 10'000'000u }) {
+        LinkedList<int> list;
+        for (int v : randomValues(n, 41)) list.insert(v);
+        list.mergeSort([](int a, int b) { return a < b; });
+        std::vector<int> toDelete = randomValues(n / 10, 43);
+        list.deleteValues(toDelete);
+        LinkedList<int> other;
+        for (int v : randomValues(n / 10, 47)) other.insert(v);
+        other.mergeSort();
+        list.merge(other);
+
+        // hops to the directly following block
+        auto sequentialPercent = [&list] {
+            std::size_t sequential = 0;
+            for (auto* node = list.head; node && node->next; node = node->next) {
+                sequential += reinterpret_cast<std::uintptr_t>(node->next) - reinterpret_cast<std::uintptr_t>(node) == sizeof(*node);
+            }
+            return 100.0 * static_cast<double>(sequential) / static_cast<double>(std::max<std::size_t>(list.size() - 1, 1));
+        };
+
+        long long checksum = 0;
+        auto rows = [&](std::string_view layout) {
+            const double sequential = sequentialPercent();
+            for (const Traversal traversal : { Traversal::Plain, Traversal::Prefetch }) {
+                long long sum = 0;
+                double ms = 0;
+                const long long misses = missCounter.count([&] {
+                    ms = timeMs([&] { list.forEach([&sum](int v) { sum += v; }, traversal); });
+                });
+                checksum = checksum ? checksum : sum;
+                if (sum != checksum) {
+                    std::cout << "FAILED - values changed by relinearize" << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+
+                std::cout << std::setw(12) << list.size() << std::setw(14) << layout << std::setw(12) << (traversal == Traversal::Plain ? "plain" : "prefetch")
+                    << std::setw(10) << std::fixed << std::setprecision(2) << ms << std::setw(12) << ms * 1e6 / static_cast<double>(list.size());
+                if (misses >= 0) std::cout << std::setw(14) << static_cast<double>(misses) / static_cast<double>(list.size());
+                else std::cout << std::setw(14) << "n/a";
+                std::cout << std::setw(14) << std::setprecision(1) << sequential << std::endl;
+            }
+        };
+
+        rows("fragmented");
+        const double relinearizeMs = timeMs([&] { list.relinearize(); });
+        rows("relinearized");
+        std::cout << std::setw(12) << list.size() << std::setw(14) << "relinearize" << std::setw(12) << "-"
+            << std::setw(10) << std::setprecision(2) << relinearizeMs << std::endl;
+        if (!list.checkInvariants()) {
+            std::cout << "FAILED - broken list after relinearize" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// 100M nodes through mergeSort and reverseRecursive - both have to stay within a constant stack depth
+// exits with a failure code if the result is not sorted / reversed
+static void benchLongList()
+{
+    constexpr std::size_t n = 100'000'000;
+    std::cout << "stack-safe sort and reverse of " << n << " nodes" << std::endl;
+
+    LinkedList<int> list;
+    std::mt19937 rng(123);
+    const double buildMs = timeMs([&] { for (std::size_t i = 0; i < n; ++i) list.insert(static_cast<int>(rng() >> 1)); });
+    std::cout << "insert: " << std::fixed << std::setprecision(0) << buildMs << " ms" << std::endl;
+
+    // a lambda keeps it on the merge sort, std::less<int> would radix sort
+    const double sortMs = timeMs([&] { list.mergeSort([](int a, int b) { return a < b; }); });
+    std::cout << "mergeSort: " << sortMs << " ms" << std::endl;
+
+    const double reverseMs = timeMs([&] { list.reverseRecursive(); });
+    std::cout << "reverseRecursive: " << reverseMs << " ms" << std::endl;
+
+    // reversed ascending order has to be non-increasing
+    std::size_t nodes = 0;
+    for (auto* node = list.head; node; node = node->next) {
+        ++nodes;
+        if (node->next && node->next->val > node->val) {
+            std::cout << "FAILED - not in descending order after node " << nodes << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    if (nodes != n || list.size() != n || !list.tail || list.tail->next) {
+        std::cout << "FAILED - lost nodes or broken tail" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    std::cout << "OK" << std::endl;
+}
+
+// operation suite options, set from the command line (--sizes=, --distributions=, --repeat=, --format=, --output=)
+struct SuiteOptions {
+    std::vector<std::size_t> sizes = { 1'000, 10'000, 100'000 };
+    std::vector<std::string> distributions = { "random", "sorted", "reversed", "sawtooth", "nearly" };
+    int repeat = 5;
+
+    // csv or json
+    std::string format = "csv";
+
+    // records go to stdout if empty
+    std::string output;
+};
+
+// one timed operation of one container, times are the minimum and the median over the repetitions
+struct SuiteRecord {
+    std::string_view container;
+    std::string_view operation;
+    std::string_view variant;
+    std::string distribution;
+    std::size_t size;
+    double minNs;
+    double medianNs;
+};
+
+// everything an operation works on, rebuilt for every repetition outside of the timed region
+// result receives whatever the operation produces, so its destruction is not timed either
+template<typename Container>
+struct SuiteInput {
+    Container a;
+    Container b;
+    Container result;
+};
+
+template<typename Container>
+static Container suiteContainer(std::span<const int> values)
+{
+    if constexpr (std::is_same_v<Container, LinkedList<int>>) {
+        Container list;
+        for (int v : values) list.insert(v);
+        return list;
+    }
+    else {
+        return Container(values.begin(), values.end());
+    }
+}
+
+// keep nodes not followed by a greater value - the baseline of removeNodesSmallerThanMaxSoFar
+template<typename Container>
+static void removeSmallerThanMaxSoFar(Container& c)
+{
+    if constexpr (std::is_same_v<Container, std::forward_list<int>>) {
+        c.reverse();
+        std::optional<int> maxSoFar;
+        c.remove_if([&maxSoFar](int v) {
+            if (maxSoFar && v < *maxSoFar) return true;
+            maxSoFar = v;
+            return false;
+        });
+        c.reverse();
+    }
+    else if constexpr (std::is_same_v<Container, std::list<int>>) {
+        std::optional<int> maxSoFar;
+        for (auto it = c.end(); it != c.begin();) {
+            --it;
+            if (maxSoFar && *it < *maxSoFar) it = c.erase(it);
+            else maxSoFar = *it;
+        }
+    }
+    else {
+        // scan from the back, compact kept values towards the end
+        auto kept = c.end();
+        for (auto it = c.end(); it != c.begin();) {
+            --it;
+            if (kept == c.end() || !(*it < *kept)) *--kept = *it;
+        }
+        c.erase(c.begin(), kept);
+    }
+}
+
+// LinkedList operations and the closest std::forward_list / std::list / std::vector equivalents
+// on every configured size and value distribution, output is one machine readable record per measurement
+static void benchSuite(const SuiteOptions& options)
+{
+    // quadratic sorts are skipped above these sizes
+    constexpr std::size_t insertionSortLimit = 20'000;
+    constexpr std::size_t bubbleSortLimit = 5'000;
+
+    std::vector<SuiteRecord> records;
+
+    for (const std::string& distribution : options.distributions) {
+        for (const std::size_t n : options.sizes) {
+            const std::vector<int> values = shapedValues(distribution, n, 7);
+
+            // sorted halves are the inputs of the merges
+            std::vector<int> low(values.begin(), values.begin() + n / 2);
+            std::vector<int> high(values.begin() + n / 2, values.end());
+            std::sort(low.begin(), low.end());
+            std::sort(high.begin(), high.end());
+
+            // deleteValue removes the middle value, deleteValues every hundredth one
+            const int deleteValue = n ? values[n / 2] : 0;
+            std::vector<int> deleteValues;
+            for (std::size_t i = 0; i < n; i += 100) deleteValues.push_back(values[i]);
+
+            auto measure = [&]<typename Container>(std::string_view container, std::string_view operation, std::string_view variant,
+                                                   std::span<const int> a, std::span<const int> b, auto&& op) {
+                std::vector<double> samples;
+                for (int r = 0; r < options.repeat; ++r) {
+                    SuiteInput<Container> input{ suiteContainer<Container>(a), suiteContainer<Container>(b), Container() };
+                    const auto start = benchClock::now();
+                    op(input);
+                    samples.push_back(elapsedNs(start, benchClock::now()));
+                }
+                std::sort(samples.begin(), samples.end());
+                records.push_back({ container, operation, variant, distribution, n, samples.front(), samples[samples.size() / 2] });
+            };
+
+            // operations shared by the std containers, spelled per container where the interfaces differ
+            auto measureStd = [&]<typename Container>(std::string_view container) {
+                auto time = [&](std::string_view operation, std::string_view variant, std::span<const int> a, std::span<const int> b, auto&& op) {
+                    measure.template operator()<Container>(container, operation, variant, a, b, op);
+                };
+                constexpr bool isForwardList = std::is_same_v<Container, std::forward_list<int>>;
+                constexpr bool isVector = std::is_same_v<Container, std::vector<int>>;
+
+                if constexpr (isForwardList) {
+                    time("insert", "insert_after", {}, {}, [&](auto& in) {
+                        auto last = in.result.before_begin();
+                        for (int v : values) last = in.result.insert_after(last, v);
+                    });
+                }
+                else {
+                    time("insert", "push_back", {}, {}, [&](auto& in) { for (int v : values) in.result.push_back(v); });
+                }
+
+                time("copy", "copy constructor", values, {}, [](auto& in) { in.result = Container(in.a); });
+
+                if constexpr (isVector) {
+                    time("operator+", "std::merge", low, high, [](auto& in) {
+                        in.result.resize(in.a.size() + in.b.size());
+                        std::merge(in.a.begin(), in.a.end(), in.b.begin(), in.b.end(), in.result.begin());
+                    });
+                    time("merge", "std::inplace_merge", low, high, [](auto& in) {
+                        const std::ptrdiff_t middle = std::ssize(in.a);
+                        in.a.insert(in.a.end(), in.b.begin(), in.b.end());
+                        std::inplace_merge(in.a.begin(), in.a.begin() + middle, in.a.end());
+                    });
+                    time("reverse", "std::reverse", values, {}, [](auto& in) { std::reverse(in.a.begin(), in.a.end()); });
+                    time("sort", "std::sort", values, {}, [](auto& in) { std::sort(in.a.begin(), in.a.end()); });
+                    time("sort", "std::stable_sort", values, {}, [](auto& in) { std::stable_sort(in.a.begin(), in.a.end()); });
+                }
+                else {
+                    time("operator+", "copy + merge", low, high, [](auto& in) {
+                        Container left(in.a);
+                        Container right(in.b);
+                        left.merge(right);
+                        in.result = std::move(left);
+                    });
+                    time("merge", "merge", low, high, [](auto& in) { in.a.merge(in.b); });
+                    time("reverse", "reverse", values, {}, [](auto& in) { in.a.reverse(); });
+                    time("sort", "sort", values, {}, [](auto& in) { in.a.sort(); });
+                }
+
+                if constexpr (isVector) {
+                    time("deleteValue", "erase(remove)", values, {}, [&](auto& in) {
+                        in.a.erase(std::remove(in.a.begin(), in.a.end(), deleteValue), in.a.end());
+                    });
+                    time("deleteValues", "erase(remove_if) + unordered_set", values, {}, [&](auto& in) {
+                        const std::unordered_set<int> set(deleteValues.begin(), deleteValues.end());
+                        in.a.erase(std::remove_if(in.a.begin(), in.a.end(), [&set](int v) { return set.contains(v); }), in.a.end());
+                    });
+                }
+                else {
+                    time("deleteValue", "remove", values, {}, [&](auto& in) { in.a.remove(deleteValue); });
+                    time("deleteValues", "remove_if + unordered_set", values, {}, [&](auto& in) {
+                        const std::unordered_set<int> set(deleteValues.begin(), deleteValues.end());
+                        in.a.remove_if([&set](int v) { return set.contains(v); });
+                    });
+                }
+
+                if (n > 0) {
+                    if constexpr (isForwardList) {
+                        time("deleteMiddleNode", "erase_after", values, {}, [n](auto& in) {
+                            in.a.erase_after(std::next(in.a.before_begin(), static_cast<std::ptrdiff_t>(n / 2)));
+                        });
+                    }
+                    else {
+                        time("deleteMiddleNode", "erase", values, {}, [n](auto& in) {
+                            in.a.erase(std::next(in.a.begin(), static_cast<std::ptrdiff_t>(n / 2)));
+                        });
+                    }
+                }
+
+                time("removeNodesSmallerThanMaxSoFar", "scan from the back", values, {}, [](auto& in) { removeSmallerThanMaxSoFar(in.a); });
+            };
+
+            // LinkedList - every sort and both reversals
+            {
+                using List = LinkedList<int>;
+                auto time = [&](std::string_view operation, std::string_view variant, std::span<const int> a, std::span<const int> b, auto&& op) {
+                    measure.template operator()<List>("LinkedList", operation, variant, a, b, op);
+                };
+                auto lambdaLess = [](int a, int b) { return a < b; };
+
+                time("insert", "insert", {}, {}, [&](auto& in) { for (int v : values) in.result.insert(v); });
+                time("copy", "copy constructor", values, {}, [](auto& in) { in.result = List(in.a); });
+                time("operator+", "operator+", low, high, [](auto& in) { in.result = in.a + in.b; });
+                time("merge", "merge", low, high, [](auto& in) { in.a.merge(in.b); });
+                time("reverse", "reverseIterative", values, {}, [](auto& in) { in.a.reverseIterative(); });
+                time("reverse", "reverseRecursive", values, {}, [](auto& in) { in.a.reverseRecursive(); });
+
+                // std::less dispatches to the radix sort, a lambda keeps mergeSort comparison based
+                time("sort", "mergeSort", values, {}, [](auto& in) { in.a.mergeSort(); });
+                time("sort", "mergeSort(lambda)", values, {}, [&](auto& in) { in.a.mergeSort(lambdaLess); });
+                time("sort", "adaptiveSort", values, {}, [](auto& in) { in.a.adaptiveSort(); });
+                time("sort", "parallelMergeSort", values, {}, [](auto& in) { in.a.parallelMergeSort(); });
+                if (n <= insertionSortLimit) {
+                    time("sort", "insertionSort", values, {}, [](auto& in) { in.a.insertionSort(); });
+                }
+                if (n <= bubbleSortLimit) {
+                    time("sort", "bubbleSort", values, {}, [](auto& in) { in.a.bubbleSort(); });
+                }
+
+                time("deleteValue", "deleteValue", values, {}, [&](auto& in) { in.a.deleteValue(deleteValue); });
+                time("deleteValues", "deleteValues", values, {}, [&](auto& in) { in.a.deleteValues(deleteValues); });
+                time("deleteMiddleNode", "deleteMiddleNode", values, {}, [](auto& in) { in.a.deleteMiddleNode(); });
+                time("removeNodesSmallerThanMaxSoFar", "removeNodesSmallerThanMaxSoFar", values, {}, [](auto& in) { in.a.removeNodesSmallerThanMaxSoFar(); });
+            }
+
+            measureStd.template operator()<std::forward_list<int>>("std::forward_list");
+            measureStd.template operator()<std::list<int>>("std::list");
+            measureStd.template operator()<std::vector<int>>("std::vector");
+        }
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) throw std::runtime_error("cannot write " + options.output);
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    out << std::fixed << std::setprecision(1);
+
+    if (options.format == "json") {
+        out << "{\n  \"benchmark\": \"suite\",\n  \"repeat\": " << options.repeat << ",\n  \"records\": [";
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const SuiteRecord& r = records[i];
+            out << (i ? ",\n" : "\n") << "    { \"container\": \"" << r.container << "\", \"operation\": \"" << r.operation
+                << "\", \"variant\": \"" << r.variant << "\", \"distribution\": \"" << r.distribution << "\", \"size\": " << r.size
+                << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs << " }";
+        }
+        out << "\n  ]\n}" << std::endl;
+    }
+    else {
+        out << "container,operation,variant,distribution,size,repeat,min_ns,median_ns" << std::endl;
+        for (const SuiteRecord& r : records) {
+            out << r.container << ',' << r.operation << ',' << r.variant << ',' << r.distribution << ',' << r.size << ','
+                << options.repeat << ',' << r.minNs << ',' << r.medianNs << std::endl;
+        }
+    }
+}
+
+struct Benchmark {
+    std::string_view name;
+    std::function<void()> run;
+
+    // long running benchmarks only run when asked for by name
+    bool explicitOnly = false;
+};
+
+// comma separated list, empty items are dropped
+static std::vector<std::string> splitList(std::string_view text)
+{
+    std::vector<std::string> items;
+    while (!text.empty()) {
+        const std::size_t comma = std::min(text.find(','), text.size());
+        if (comma > 0) items.emplace_back(text.substr(0, comma));
+        text.remove_prefix(std::min(comma + 1, text.size()));
+    }
+    return items;
+}
+
+// apply a --name=value option, false if it is unknown or malformed
+static bool parseSuiteOption(std::string_view arg, SuiteOptions& options)
+{
+    const std::size_t equals = arg.find('=');
+    if (equals == std::string_view::npos) return false;
+    const std::string_view name = arg.substr(0, equals);
+    const std::string_view value = arg.substr(equals + 1);
+
+    try {
+        if (name == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value)) options.sizes.push_back(std::stoull(size));
+            return !options.sizes.empty();
+        }
+        if (name == "--distributions") {
+            options.distributions = splitList(value);
+            for (const std::string& distribution : options.distributions) {
+                if (distribution != "random" && distribution != "sorted" && distribution != "reversed" &&
+                    distribution != "sawtooth" && distribution != "nearly") return false;
+            }
+            return !options.distributions.empty();
+        }
+        if (name == "--repeat") {
+            options.repeat = std::stoi(std::string(value));
+            return options.repeat > 0;
+        }
+    }
+    catch (const std::logic_error&) {
+        return false;
+    }
+    if (name == "--format") {
+        options.format = value;
+        return value == "csv" || value == "json";
+    }
+    if (name == "--output") {
+        options.output = value;
+        return !value.empty();
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    // options start with --, every other argument names a benchmark
+    SuiteOptions suiteOptions;
+    std::vector<std::string_view> names;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (!arg.starts_with("--")) {
+            names.push_back(arg);
+        }
+        else if (!parseSuiteOption(arg, suiteOptions)) {
+            std::cerr << "invalid option " << arg << std::endl;
+            std::cerr << "suite options: --sizes=1000,100000 --distributions=random,sorted,reversed,sawtooth,nearly "
+                "--repeat=5 --format=csv|json --output=file" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::vector<Benchmark> benchmarks = {
+        { "append", benchAppend },
+        { "unrolled", benchUnrolled },
+        { "comparator", benchComparator },
+        { "parallel", benchParallelSort },
+        { "adaptive", benchAdaptiveSort },
+        { "radix", benchRadixSort },
+        { "kway", benchKWayMerge },
+        { "delete", benchDeleteValues },
+        { "concurrent", benchConcurrentList },
+        { "persist", benchPersistentList },
+        { "skiplist", benchSkipListIndex },
+        { "relinearize", benchRelinearize },
+        { "indexed", benchIndexedList },
+        { "cow", benchSharedList },
+        { "ranges", benchRanges },
+        { "instrument", benchInstrumentation },
+        { "external", benchExternalSort },
+        { "setops", benchSetOperations },
+        { "longlist", benchLongList, true },
+        { "suite", [&suiteOptions] { benchSuite(suiteOptions); }, true },
+    };
+
+    // no names - run everything, otherwise only the named benchmarks
+    for (const auto& benchmark : benchmarks) {
+        bool selected = names.empty() && !benchmark.explicitOnly;
+        for (const std::string_view name : names) {
+            selected = selected || benchmark.name == name;
+        }
+        if (selected) {
+            benchmark.run();
+            // the suite output stays machine readable
+            if (benchmark.name != "suite") std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
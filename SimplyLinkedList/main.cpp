@@ -1,480 +1,72 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
-#include <set>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <functional>
-
-// singly-linked list
-struct ListNode {
-    int val;
-    ListNode* next;
-    ListNode() : val(0), next(nullptr) {}
-    ListNode(int x) : val(x), next(nullptr) {}
-    ListNode(int x, ListNode* next) : val(x), next(next) {}
-};
-
-class LinkedList {
-public:
-    ListNode* head;
-    LinkedList() : head(nullptr) {}
-
-    // copy constructor
-    // to initialize a previously uninitialized object from some other object's data
-    LinkedList(const LinkedList& other) : head(nullptr) {
-        if (other.head) {
-            head = new ListNode(other.head->val);
-            ListNode* temp = head;
-            ListNode* otherTemp = other.head->next;
-            while (otherTemp) {
-                temp->next = new ListNode(otherTemp->val);
-                temp = temp->next;
-                otherTemp = otherTemp->next;
-            }
-        }
-    }
-
-    int size()
-    {
-        int sizeOfLL = 0;
-        ListNode* temp = head;
-        while (temp)
-        {
-            ++sizeOfLL;
-            temp = temp->next;
-        }
-
-        return sizeOfLL;
-    }
-
-    // assignment operator
-    // to replace the data of a previously initialized object with some other object's data
-    LinkedList& operator=(const LinkedList& other) {
-        if (this == &other) return *this; // handle self-assignment
-
-        // clear existing list
-        while (head) {
-            ListNode* temp = head;
-            head = head->next;
-            delete temp;
-        }
-
-        // copy from other
-        if (other.head) {
-            head = new ListNode(other.head->val);
-            ListNode* temp = head;
-            ListNode* otherTemp = other.head->next;
-            while (otherTemp) {
-                temp->next = new ListNode(otherTemp->val);
-                temp = temp->next;
-                otherTemp = otherTemp->next;
-            }
-        }
-        return *this;
-    }
-
-    // insert at the end
-    void insert(int val) {
-        if (!head) {
-            head = new ListNode(val);
-            return;
-        }
-        ListNode* temp = head;
-        while (temp->next) temp = temp->next;
-        temp->next = new ListNode(val);
-    }
-
-    // delete all nodes with a specific value
-    void deleteValue(int val)
-    {
-        while (head && head->val == val) {
-            ListNode* temp = head;
-            head = head->next;
-            delete temp;
-        }
-        ListNode* current = head;
-        while (current && current->next) {
-            if (current->next->val == val) {
-                ListNode* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-            }
-            else {
-                current = current->next;
-            }
-        }
-    }
-
-    // delete all nodes with a specific values
-    void deleteValues(std::vector<int>& values)
-    {
-        if (!head)
-            return;
-
-        std::set<int> deleteSet(values.begin(), values.end());
-        if (deleteSet.empty())
-            return;
-
-        // dummy node to handle head deletions
-        ListNode* dummy = new ListNode(0, head);
-        ListNode* current = dummy;
-
-        while (current->next) {
-            // whether value should be deleted
-            if (deleteSet.find(current->next->val) != deleteSet.end())
-            {
-                ListNode* temp = current->next;
-                current->next = current->next->next; // skip the node
-                delete temp; // free memory
-            }
-            else {
-                current = current->next; // progress with traversal
-            }
-        }
-
-        head = dummy->next; // update head in case the first node was deleted
-        delete dummy; // clean up dummy node
-    }
-
-    // delete the middle node
-    void deleteMiddleNode()
-    {
-        if (!head)
-            return;
-
-        // find size of list and calc mid position
-        int middleOffset = 0;
-        ListNode* temp = head;
-        while (temp)
-        {
-            ++middleOffset;
-            temp = temp->next;
-        }
-        middleOffset = middleOffset  / 2;
-
-        // find mid list element
-        ListNode* midElement = head;
-        while (--middleOffset > 0)
-        {
-            midElement = midElement->next;
-        }
-
-        // eliminate mid list element
-        if (midElement->next)
-        {
-            temp = midElement->next;
-            midElement->next = midElement->next->next;
-            delete temp;
-            temp = nullptr;
-        }
-        else
-        {
-            // only one element
-            delete head;
-            head = nullptr;
-        }
-    }
-
-    void reverseIterative()
-    {
-        ListNode* prev = nullptr;
-        ListNode* current = head;
-        ListNode* next = nullptr;
-
-        while (current) {
-            next = current->next; // store next node
-            current->next = prev; // reverse the link
-            prev = current;       // move prev forward
-            current = next;       // move current forward
-        }
-
-        head = prev; // update head to the new first node
-    }
-
-    void reverseRecursive() {
-        head = reverseRecursiveInternal(head);
-    }
-
-    ListNode* reverseRecursiveInternal(ListNode* node)
-    {
-        // base case - last node becomes new head
-        if (!node || !node->next) return node; 
-
-        // recursively reverse rest
-        ListNode* newHead = reverseRecursiveInternal(node->next);
-        // reverse the link
-        node->next->next = node;
-        // set current nodes next to null
-        node->next = nullptr;    
-
-        // return new head node
-        return newHead; 
-    }
-
-    void removeNodesSmallerThanMaxSoFar()
-    {
-        // empty or single-node list
-        if (!head || !head->next)
-            return;
-
-        // step 1 - reverse the linked list
-        reverseIterative();
-
-        // step 2 - remove nodes that are smaller than the max seen so far
-        ListNode* maxNode = head; // first node is the max initially
-
-        ListNode* current = head;
-        while (current && current->next) {
-            if (current->next->val < maxNode->val) {
-                // delete the smaller node
-                ListNode* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-            }
-            else {
-                // update maxNode if we find a larger value
-                current = current->next;
-                maxNode = current;
-            }
-        }
-
-        // step 3 - reverse back to original order
-        reverseIterative();
-    }
-
-    // in-place merge another sorted linked-list
-    void merge(LinkedList& other, std::function<bool(int, int)> comp = std::less<int>())
-    {
-        // target linked-list is empty
-        if (!head) {
-            head = other.head;
-            other.head = nullptr;
-            return;
-        }
-
-        // source linked-list is empty, nothing to do
-        if (!other.head) return;
-
-        // placeholder to simplify list merging / fixed starting point
-        ListNode* dummy = new ListNode(0);
-
-        // always points to the last merged node
-        ListNode* tail = dummy;
-
-        ListNode* l1 = head;
-        ListNode* l2 = other.head;
-
-        while (l1 && l2) {
-            // attach node to tail->next
-            // move forward l1 / l2
-            if (comp(l1->val, l2->val)) {
-                tail->next = l1;
-                l1 = l1->next;
-            }
-            else {
-                tail->next = l2;
-                l2 = l2->next;
-            }
-            // move tail forward
-            tail = tail->next;
-        }
-
-        // attaching remaining elements
-        tail->next = (l1) ? l1 : l2;
-
-        // assigning the new head
-        head = dummy->next;
-        
-        // merging done
-        delete dummy;
-        other.head = nullptr;
-        
-    }
-
-    // merge two sorted linked lists in an iterative fashion
-    static ListNode* mergeIterative(ListNode* l1, ListNode* l2, std::function<bool(int, int)> comp)
-    {
-        // if either list is empty, return the other list.
-        if (!l1) return l2;
-        if (!l2) return l1;
-
-        // ensure l1 is the smaller head
-        if (l1->val > l2->val) std::swap(l1, l2);
-        ListNode* head = l1;
-
-        // traverse l1, inserting nodes from l2 in their correct positions
-        while (l1->next && l2) {
-            // move the l2 node into l1
-            if (l2->val < l1->next->val)
-            {
-                ListNode* temp = l2;
-                l2 = l2->next;
-                temp->next = l1->next;
-                l1->next = temp;
-            }
-            l1 = l1->next;
-        }
-
-        // if l1 reaches the end, append remaining l2
-        if (!l1->next) l1->next = l2;
-        
-        return head;
-    }
-
-    // merge two sorted linked lists in a recursive fashion - GfG
-    static ListNode* mergeRecursive(ListNode* l1, ListNode* l2, std::function<bool(int, int)> comp)
-    {
-        // if either list is empty, return the other list
-        if (l1 == nullptr) return l2;
-        if (l2 == nullptr) return l1;
-
-        // pick the smaller value between l1 and l2 nodes
-        if (comp(l1->val, l2->val)) {
-
-            // recursively merge the rest of the lists
-            // and link the result to the current node
-            l1->next = mergeRecursive(l1->next, l2, comp);
-            return l1;
-        }
-        else {
-            // recursively merge the rest of the lists
-            // and link the result to the current node
-            l2->next = mergeRecursive(l1, l2->next, comp);
-            return l2;
-        }
-    }
-    
-    // insertion sort
-    void insertionSort(std::function<bool(int, int)> comp = std::less<int>())
-    {
-        ListNode* sorted = nullptr;
-        while (head) {
-            ListNode* node = head;
-            head = head->next;
-            if (!sorted || comp(node->val, sorted->val)) {
-                node->next = sorted;
-                sorted = node;
-            }
-            else {
-                ListNode* temp = sorted;
-                while (temp->next && !comp(node->val, temp->next->val))
-                    temp = temp->next;
-                node->next = temp->next;
-                temp->next = node;
-            }
-        }
-        head = sorted;
-    }
-
-    // bubble sort
-    void bubbleSort(std::function<bool(int, int)> comp = std::less<int>())
-    {
-        if (!head || !head->next) return;
-
-        bool swapped;
-        do {
-            swapped = false;
-            ListNode* current = head;
-            while (current->next) {
-                if (comp(current->next->val, current->val))
-                {
-                    std::swap(current->val, current->next->val);
-                    swapped = true;
-                }
-                current = current->next;
-            }
-        } while (swapped);
-    }
-
-    // merge sort
-    void mergeSort(std::function<bool(int, int)> comp = std::less<int>())
-    {
-        head = mergeSortInternal(head, comp);
-    }
-
-    // merge sort helper
-    ListNode* mergeSortInternal(ListNode* node, std::function<bool(int, int)> comp)
-    {
-        // if the list is empty or has only one node, it's already sorted
-        if (!node || !node->next) return node;
-
-        // split the list into two halves
-        ListNode* slow = node;
-        ListNode* fast = node->next;
-        while (fast && fast->next) {
-            slow = slow->next;
-            fast = fast->next->next;
-        }
-        ListNode* mid = slow->next;
-        slow->next = nullptr;
-
-        // recursively sort each half
-        ListNode* left = mergeSortInternal(node, comp);
-        ListNode* right = mergeSortInternal(mid, comp);
-
-        // merge the two sorted halves
-        return mergeRecursive(left, right, comp);
-    }
-
-    // display the linked list
-    void display() {
-        ListNode* temp = head;
-        while (temp) {
-            std::cout << temp->val << " -> ";
-            temp = temp->next;
-        }
-        std::cout << "NULL" << std::endl;
-    }
-
-    static ListNode* deepCopy(ListNode* head) {
-        if (!head) return nullptr;
-        ListNode* newHead = new ListNode(head->val);
-        ListNode* current = newHead;
-        head = head->next;
-
-        while (head) {
-            current->next = new ListNode(head->val);
-            current = current->next;
-            head = head->next;
-        }
-        return newHead;
-    }
-
-    // operator overloading to merge two lists safely
-    LinkedList operator+(const LinkedList& other) {
-        LinkedList result;
-        ListNode* copy1 = deepCopy(this->head);
-        ListNode* copy2 = deepCopy(other.head);
-        result.head = mergeIterative(copy1, copy2, std::less<int>());
-        return result;
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "ConcurrentSortedList.h"
+#include "ExternalSort.h"
+#include "IndexedList.h"
+#include "LinkedList.h"
+#include "PersistentList.h"
+#include "SharedList.h"
+#include "SkipListIndex.h"
+#include "UnrolledLinkedList.h"
+
+// record type counting its copies and moves
+struct CopyCounted {
+    int key;
+    std::string name;
+
+    inline static int copies = 0;
+    inline static int moves = 0;
+
+    CopyCounted(int k, std::string n) : key(k), name(std::move(n)) {}
+    CopyCounted(const CopyCounted& other) : key(other.key), name(other.name) { ++copies; }
+    CopyCounted(CopyCounted&& other) noexcept : key(other.key), name(std::move(other.name)) { ++moves; }
+    CopyCounted& operator=(const CopyCounted& other) { key = other.key; name = other.name; ++copies; return *this; }
+    CopyCounted& operator=(CopyCounted&& other) noexcept { key = other.key; name = std::move(other.name); ++moves; return *this; }
+
+    bool operator<(const CopyCounted& other) const { return key < other.key; }
+    bool operator>(const CopyCounted& other) const { return key > other.key; }
+
+    friend std::ostream& operator<<(std::ostream& os, const CopyCounted& record) {
+        return os << record.key << ":" << record.name;
     }
+};
 
-    // destructor to delete entire list
-    ~LinkedList() {
-        ListNode* current = head;
-        while (current) {
-            ListNode* next = current->next;
-            delete current;
-            current = next;
-        }
-        head = nullptr;
+static LinkedList<CopyCounted> makeRecords(std::initializer_list<int> keys, const std::string& prefix) {
+    LinkedList<CopyCounted> records;
+    for (const int key : keys) {
+        records.emplace(key, prefix + std::to_string(key));
     }
-};
+    return records;
+}
 
 int main() {
-    LinkedList list1;
+    LinkedList<int> list1;
     list1.insert(1);
     list1.insert(3);
     list1.insert(5);
     list1.insert(6);
     list1.insert(7);
 
-    LinkedList list2;
+    LinkedList<int> list2;
     list2.insert(2);
     list2.insert(4);
     list2.insert(6);
     list2.insert(8);
 
-    int list1Size = list1.size();
-    int list2Size = list2.size();
+    std::size_t list1Size = list1.size();
+    std::size_t list2Size = list2.size();
 
     std::cout << "list 1: ";
     list1.display();
@@ -484,7 +76,7 @@ int main() {
 
     std::cout << "merge linked-lists into new list" << std::endl;
     {
-        LinkedList mergedList = list1 + list2;
+        LinkedList<int> mergedList = list1 + list2;
         std::cout << "merged List: ";
         mergedList.display();
 
@@ -511,7 +103,7 @@ int main() {
     }
     std::cout << std::endl;
 
-    LinkedList listRandom;
+    LinkedList<int> listRandom;
     for (const auto i : { 4, 3, 5, 6, 1, 8, 2, 4, 7, 6 }) {
         listRandom.insert(i);
     }
@@ -528,30 +120,61 @@ int main() {
     {
         std::cout << "insertion sort - less" << std::endl;
         {
-            LinkedList listSorted(listRandom);
+            LinkedList<int> listSorted(listRandom);
             listSorted.insertionSort(std::less<int>());
             listSorted.display();
         }
 
         std::cout << "bubble sort - greater" << std::endl;
         {
-            LinkedList listSorted(listRandom);
+            LinkedList<int> listSorted(listRandom);
             listSorted.bubbleSort(std::greater<int>());
             listSorted.display();
         }
 
         std::cout << "merge sort - less" << std::endl;
         {
-            LinkedList listSorted(listRandom);
+            LinkedList<int> listSorted(listRandom);
             listSorted.mergeSort(std::less<int>());
             listSorted.display();
         }
+
+        std::cout << "adaptive (natural run) sort - less" << std::endl;
+        {
+            LinkedList<int> listSorted(listRandom);
+            listSorted.adaptiveSort();
+            listSorted.display();
+        }
+
+        std::cout << "parallel merge sort - greater, 4 threads (short lists fall back to mergeSort)" << std::endl;
+        {
+            LinkedList<int> listSorted(listRandom);
+            listSorted.parallelMergeSort(std::greater<int>(), 4);
+            listSorted.display();
+        }
+    }
+    std::cout << std::endl;
+
+    std::cout << "k-way merge of sorted lists" << std::endl;
+    {
+        LinkedList<int> target;
+        for (const auto i : { 1, 5, 9 }) {
+            target.insert(i);
+        }
+        std::vector<LinkedList<int>> shards(3);
+        for (const auto i : { 2, 6, 10 }) shards[0].insert(i);
+        for (const auto i : { 0, 7 }) shards[1].insert(i);
+        for (const auto i : { 3, 4, 8, 11 }) shards[2].insert(i);
+
+        target.mergeKWay(std::span(shards));
+        target.display();
+        std::cout << "size: " << target.size() << " - nodes left in shards: " << shards[0].size() + shards[1].size() + shards[2].size() << std::endl;
     }
     std::cout << std::endl;
 
     std::cout << "delete middle element" << std::endl;
     {
-        LinkedList deleteMidList;
+        LinkedList<int> deleteMidList;
         for (const auto i : { 1 }) {
             deleteMidList.insert(i);
         }
@@ -563,7 +186,7 @@ int main() {
 
     std::cout << "delete values" << std::endl;
     {
-        LinkedList deleteValuesList;
+        LinkedList<int> deleteValuesList;
         for (const auto i : { 1,2,3,4,1,2,5,7,2,3,1 }) {
             deleteValuesList.insert(i);
         }
@@ -576,7 +199,7 @@ int main() {
 
     std::cout << "remove every node which has a node with a greater value anywhere to the right side of it" << std::endl;
     {
-        LinkedList myList;
+        LinkedList<int> myList;
         for (const auto i : { 5,2,13,3,8 }) {
             myList.insert(i);
         }
@@ -585,6 +208,369 @@ int main() {
         myList.removeNodesSmallerThanMaxSoFar();
         myList.display();
     }
+    std::cout << std::endl;
+
+    std::cout << "pooled nodes - chunk mallocs for building and tearing down a list" << std::endl;
+    {
+        for (const int n : { 1'000, 100'000, 1'000'000 }) {
+            const std::size_t chunksBefore = NodePool::totalChunkAllocations();
+            {
+                LinkedList<int> pooledList;
+                for (int i = 0; i < n; ++i) {
+                    pooledList.insert(i);
+                }
+                std::cout << "nodes: " << n << " - chunks held by list: " << pooledList.alloc.ownedChunks();
+
+                LinkedList<int> pooledCopy(pooledList);
+                pooledCopy.deleteValue(0);
+            }
+            std::cout << " - chunk mallocs for list + copy: " << NodePool::totalChunkAllocations() - chunksBefore << std::endl;
+        }
+    }
+    std::cout << std::endl;
+
+    std::cout << "unrolled linked-list - " << UnrolledNode::capacity << " values per cache line" << std::endl;
+    {
+        UnrolledLinkedList unrolledList;
+        for (int i = 0; i < 40; ++i) {
+            unrolledList.insert((i * 7) % 23);
+        }
+        std::cout << "blocks: " << unrolledList.blocks() << " - ";
+        unrolledList.display();
+
+        unrolledList.deleteValue(0);
+        std::vector<int> valuesToDelete{ 1, 2, 3 };
+        unrolledList.deleteValues(valuesToDelete);
+        std::cout << "delete 0, 1, 2, 3: ";
+        unrolledList.display();
+
+        unrolledList.reverse();
+        std::cout << "reverse: ";
+        unrolledList.display();
+
+        UnrolledLinkedList insertionSorted(unrolledList);
+        insertionSorted.insertionSort(std::greater<int>());
+        std::cout << "insertion sort - greater: ";
+        insertionSorted.display();
+
+        unrolledList.mergeSort();
+        std::cout << "merge sort - less: ";
+        unrolledList.display();
+
+        UnrolledLinkedList other;
+        for (const auto i : { 1, 3, 5, 30 }) {
+            other.insert(i);
+        }
+        unrolledList.merge(other);
+        std::cout << "merged with 1 3 5 30: ";
+        unrolledList.display();
+        std::cout << "size: " << unrolledList.size() << " - blocks: " << unrolledList.blocks() << std::endl;
+
+        // merging a list into itself leaves it as it is
+        unrolledList.merge(unrolledList);
+        std::cout << "merged with itself - size: " << unrolledList.size() << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    std::cout << "lock-free sorted list - 4 threads insert interleaved values, odd values are deleted again" << std::endl;
+    {
+        ConcurrentSortedList<int> concurrentList;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&concurrentList, t] {
+                for (int i = t; i < 20; i += 4) concurrentList.insert(i);
+                for (int i = t; i < 20; i += 4) {
+                    if (i % 2) concurrentList.deleteValue(i);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        concurrentList.forEach([](int val) { std::cout << val << " -> "; });
+        std::cout << "NULL" << std::endl;
+        std::cout << "size: " << concurrentList.size() << " - contains 4: " << concurrentList.contains(4) << " - contains 5: " << concurrentList.contains(5) << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "list file - saved, mapped and traversed in place" << std::endl;
+    {
+        LinkedList<int> saved;
+        for (const auto i : { 8, 3, 5, 1 }) {
+            saved.insert(i);
+        }
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "SimplyLinkedList.sll";
+        saveList(saved, path);
+        {
+            const MappedList<int> mapped(path);
+            std::cout << "mapped: ";
+            mapped.display();
+            std::cout << "size: " << mapped.size() << " - sequential: " << mapped.isSequential() << std::endl;
+
+            LinkedList<int> loaded = loadList<int>(path);
+            loaded.mergeSort();
+            std::cout << "loaded and sorted: ";
+            loaded.display();
+        }
+
+        // corrupt the link of the last node - far out of range, then back to the head (a cycle),
+        // then end the chain at the second node (fewer nodes than the header counts)
+        const std::pair<std::size_t, std::uint64_t> corruptions[] = {
+            { 3, ~std::uint64_t{ 7 } },
+            { 3, listFileFirstNode<int>() },
+            { 1, 0 },
+        };
+        for (const auto& [slot, link] : corruptions) {
+            {
+                std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+                file.seekp(static_cast<std::streamoff>(listFileFirstNode<int>() + slot * sizeof(ListFileNode<int>) + offsetof(ListFileNode<int>, next)));
+                file.write(reinterpret_cast<const char*>(&link), sizeof(link));
+            }
+            try {
+                const MappedList<int> mapped(path);
+                std::size_t traversed = 0;
+                for ([[maybe_unused]] const int val : mapped) ++traversed;
+                std::cout << "traversed " << traversed << " nodes" << std::endl;
+            }
+            catch (const std::runtime_error& error) {
+                std::cout << error.what() << std::endl;
+            }
+        }
+        std::filesystem::remove(path);
+    }
+    std::cout << std::endl;
+
+    std::cout << "external sort - four times the memory budget, spilled to sorted runs and merged back" << std::endl;
+    {
+        ExternalSortOptions options;
+        options.memoryBudget = std::size_t{ 256 } << 10;
+        const std::size_t n = 4 * options.memoryBudget / sizeof(int);
+
+        // half of the values come from a list, the other half from a stream of packed integers
+        LinkedList<int> source;
+        std::vector<int> packed;
+        for (std::size_t i = 0; i < n; ++i) {
+            const int value = static_cast<int>((i * 2654435761u) % 1000003);
+            if (i % 2) packed.push_back(value);
+            else source.insert(value);
+        }
+        std::istringstream stream(std::string(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(int)));
+
+        ExternalSorter<int> sorter(options);
+        sorter.add(source);
+        sorter.addStream(stream);
+        LinkedList<int> sorted = sorter.sortedList();
+
+        const ExternalSortStats& stats = sorter.statistics();
+        std::cout << "values: " << sorted.size() << " - runs: " << stats.runs << " - merge passes: " << stats.mergePasses
+            << " - sorted: " << std::ranges::is_sorted(sorted) << " - source left: " << source.size() << std::endl;
+        std::cout << "first values: ";
+        for (int v : sorted | std::views::take(5)) std::cout << v << " ";
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "relinearize - nodes moved into fresh memory in list order after a sort scattered them" << std::endl;
+    {
+        LinkedList<int> scattered;
+        for (int v : { 42, 7, 19, 3, 25, 11, 30, 1 }) {
+            scattered.insert(v);
+        }
+        scattered.mergeSort([](int a, int b) { return a < b; });
+
+        // hops from a node to the block right behind it
+        auto sequentialHops = [&scattered] {
+            int hops = 0;
+            for (auto* node = scattered.head; node && node->next; node = node->next) {
+                hops += node->next == node + 1;
+            }
+            return hops;
+        };
+        std::cout << "sequential hops before: " << sequentialHops();
+        scattered.relinearize();
+        std::cout << ", after: " << sequentialHops() << " of " << scattered.size() - 1 << std::endl;
+        scattered.display(Traversal::Prefetch);
+    }
+    std::cout << std::endl;
+
+    std::cout << "indexed list - values and 32-bit links in two arrays, erased slots are recycled" << std::endl;
+    {
+        IndexedList<int> indexed;
+        for (int v : { 12, 5, 30, 5, 18, 2, 9 }) {
+            indexed.insert(v);
+        }
+        indexed.deleteValue(5);
+        indexed.insert(7);
+        std::cout << "after deleting 5 and inserting 7 - " << indexed.size() << " values in " << indexed.slots() << " slots: ";
+        indexed.display();
+
+        IndexedList<int> other;
+        for (int v : { 1, 10, 40 }) {
+            other.insert(v);
+        }
+        indexed.mergeSort();
+        indexed.merge(other);
+        indexed.compact();
+        std::cout << "sorted, merged and compacted - values array in list order: ";
+        for (int v : indexed.values) {
+            std::cout << v << " ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "copy-on-write list - copies share the chain, a write copies the prefix up to the modified node" << std::endl;
+    {
+        SharedList<int> original;
+        for (int i = 1; i <= 8; ++i) {
+            original.insert(i * 10);
+        }
+        SharedList<int> copy1(original);
+        SharedList<int> copy2(original);
+        std::cout << "after two copies - nodes shared by the original: " << original.sharedNodes() << " of " << original.size() << std::endl;
+
+        copy1.deleteMiddleNode();
+        copy2.pushFront(5);
+        std::cout << "copy1 without its middle node: ";
+        copy1.display();
+        std::cout << "copy2 with 5 in front: ";
+        copy2.display();
+        std::cout << "original: ";
+        original.display();
+        std::cout << "shared nodes - copy1: " << copy1.sharedNodes() << ", copy2: " << copy2.sharedNodes() << std::endl;
+
+        SharedList<int> tail;
+        for (int v : { 15, 25 }) {
+            tail.insert(v);
+        }
+        const SharedList<int> merged = tail + original;
+        std::cout << "merged with 15 and 25 - copied " << merged.size() - merged.sharedNodes() << " nodes: ";
+        merged.display();
+    }
+    std::cout << std::endl;
+
+    std::cout << "iterators and ranges - views run on the list without copying it into a vector" << std::endl;
+    {
+        LinkedList<int> numbers(from_range, std::views::iota(1, 21));
+        std::cout << "squares of the first four multiples of 3: ";
+        for (int v : numbers | std::views::filter([](int x) { return x % 3 == 0; })
+                             | std::views::transform([](int x) { return x * x; })
+                             | std::views::take(4)) {
+            std::cout << v << " ";
+        }
+        std::cout << std::endl;
+
+        numbers.erase_after(numbers.before_begin(), std::ranges::find(numbers, 15));
+        numbers.insert_after(numbers.before_begin(), 0);
+        numbers.insert_after(std::ranges::find(numbers, 17), 42);
+        std::cout << "erase 1..14, insert 0 in front and 42 behind 17: ";
+        numbers.display();
+        std::cout << "max: " << *std::ranges::max_element(numbers) << ", values above 18: " << std::ranges::count_if(numbers, [](int x) { return x > 18; }) << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "set algebra - in place on sorted lists, duplicates counted like in std::set_union" << std::endl;
+    {
+        const std::vector<int> left{ 1, 2, 2, 3, 5, 8, 13 };
+        const std::vector<int> right{ 2, 3, 3, 4, 5, 6, 7, 8 };
+        auto show = [&](const char* name, auto op) {
+            LinkedList<int> a(from_range, left);
+            LinkedList<int> b(from_range, right);
+            op(a, b);
+            std::cout << name << ": ";
+            a.display();
+        };
+        show("union", [](auto& a, auto& b) { a.setUnion(b); });
+        show("intersection", [](auto& a, auto& b) { a.setIntersection(b); });
+        show("difference", [](auto& a, auto& b) { a.setDifference(b); });
+        show("symmetric difference", [](auto& a, auto& b) { a.setSymmetricDifference(b); });
+        show("deduplicating merge", [](auto& a, auto& b) { a.mergeUnique(b); });
+    }
+    std::cout << std::endl;
+
+    std::cout << "instrumentation - per-operation counters of a list, dumped as JSON" << std::endl;
+    {
+        using CountedList = LinkedList<int, PoolAllocator<int>, CountingInstrumentation>;
+        auto byValue = [](int a, int b) { return a < b; };
+
+        CountedList numbers;
+        for (int i = 0; i < 1000; ++i) numbers.insert((i * 7919) % 1000);
+        CountedList copy(numbers);
+        copy.mergeSort(byValue);
+        numbers.adaptiveSort(byValue);
+        numbers.merge(copy, byValue);
+        numbers.deleteValue(500);
+        std::vector<int> deletes{ 1, 2, 3 };
+        numbers.deleteValues(deletes);
+        numbers.deleteMiddleNode();
+
+        CountedList small(from_range, std::views::iota(0, 64) | std::views::reverse);
+        small.insertionSort(byValue);
+        small.bubbleSort(std::greater<int>());
+
+        std::cout << "numbers: ";
+        numbers.instrumentation.writeJson(std::cout);
+        std::cout << "copy: ";
+        copy.instrumentation.writeJson(std::cout);
+        std::cout << "small: ";
+        small.instrumentation.writeJson(std::cout);
+
+        // the companions of LinkedList take instrumented lists as well
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "SimplyLinkedListCounted.sll";
+        saveList(small, path);
+        CountedList loaded = loadList<int, PoolAllocator<int>, CountingInstrumentation>(path);
+        std::filesystem::remove(path);
+        const SharedList<int> shared(loaded);
+        SkipListIndex<int, PoolAllocator<int>, std::greater<int>, CountingInstrumentation> index(loaded, std::greater<int>());
+        std::cout << "loaded: " << loaded.size() << " - shared: " << shared.size() << " - indexed 42: " << (index.find(42) ? index.find(42)->val : -1) << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "skip-list index - O(log n) search, sorted insert and range erase on a sorted list" << std::endl;
+    {
+        LinkedList<int> sorted;
+        for (int i = 0; i < 40; i += 2) {
+            sorted.insert(i);
+        }
+        SkipListIndex<int> index(sorted);
+
+        index.insert(7);
+        index.insert(25);
+        std::cout << "after inserting 7 and 25: ";
+        sorted.display();
+        std::cout << "lowerBound(13): " << index.lowerBound(13)->val << " - find(13): " << (index.find(13) ? "found" : "none") << std::endl;
+        std::cout << "erase [10, 20): " << index.erase(10, 20) << " nodes - ";
+        sorted.display();
+
+        // the merge goes around the index, it is rebuilt on the next lookup
+        LinkedList<int> other;
+        for (int i = 1; i < 10; i += 4) {
+            other.insert(i);
+        }
+        sorted.merge(other);
+        std::cout << "after merge - index stale: " << index.stale() << ", find(5): " << (index.find(5) ? "found" : "none")
+            << ", stale: " << index.stale() << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "generic list of records - rvalue paths relink nodes instead of copying" << std::endl;
+    {
+        LinkedList<CopyCounted> records1 = makeRecords({ 1, 4, 9 }, "a");
+        LinkedList<CopyCounted> records2 = makeRecords({ 2, 3, 10 }, "b");
+        CopyCounted::copies = 0;
+
+        LinkedList<CopyCounted> merged = std::move(records1) + std::move(records2);
+        LinkedList<CopyCounted> moved(std::move(merged));
+        LinkedList<CopyCounted> assigned;
+        assigned = std::move(moved);
+
+        std::cout << "merged: ";
+        assigned.display();
+        std::cout << "copies on rvalue paths: " << CopyCounted::copies << std::endl;
+
+        LinkedList<CopyCounted> copied = assigned + makeRecords({ 5 }, "c");
+        std::cout << "copies for lvalue + rvalue: " << CopyCounted::copies << " (" << assigned.size() << " elements of the lvalue)" << std::endl;
+    }
 
     return 0;
 }